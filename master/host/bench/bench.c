@@ -0,0 +1,285 @@
+/**
+ * @file bench.c
+ * @brief Host microbenchmarks of the firmware hot paths
+ *
+ *   bench [filter]
+ *
+ * Runs every benchmark whose name contains filter (all by default) and
+ * prints ns per operation. Host numbers do not transfer to the ESP32 in
+ * absolute terms; use them to compare two versions of the same code.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "config.h"
+#include "control.h"
+#include "display.h"
+#include "drive_shaping.h"
+#include "espnow_handler.h"
+#include "event_bus.h"
+#include "font.h"
+#include "fsm.h"
+#include "hal_host.h"
+#include "mode_mecanum.h"
+#include "motor.h"
+#include "motor_pwm_mock.h"
+#include "protocol.h"
+#include "types.h"
+#include "ui_common.h"
+
+typedef struct {
+  const char *name;
+  void (*setup)(void);
+  void (*run)(uint32_t iter); // One operation
+  uint32_t iterations;
+} bench_t;
+
+// Keeps results alive across the optimizer
+static volatile int32_t s_sink;
+
+static uint64_t now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+// ============================================================
+// CONTROL LOOP
+// ============================================================
+// Clock frozen so the link never times out
+static void control_setup(void) {
+  hal_clock_host_set(1000000);
+  memset(&g_ctx, 0, sizeof(g_ctx));
+  motor_pwm_mock_reset();
+  motor_init();
+  motor_set_calibration(255, 255, 255, 255);
+  event_bus_init();
+  fsm_init();
+  fsm_change_state(STATE_MODE_MECANUM);
+  g_ctx.joystick_connected = true;
+  g_ctx.last_joystick_time = 1000;
+}
+
+// One cycle with a fresh input: timeout tick, mode, ramp, PWM write
+static void control_run(uint32_t i) {
+  // Varies every wheel speed but stays forward, so nothing is logged
+  g_ctx.joystick.throttle = (int16_t)(128 + i % 128);
+  g_ctx.joystick.steering = (int16_t)(i % 64) - 32;
+  control_step();
+  s_sink = g_ctx.motor_speeds.fl;
+}
+
+// ============================================================
+// SHAPING AND MIXING
+// ============================================================
+// Inputs sweep the stick grid so the desaturation branch is taken too
+static void shaping_run(uint32_t i) {
+  s_sink = shaping_axis((int16_t)(i % 511) - 255);
+}
+
+static void mecanum_run(uint32_t i) {
+  motor_speeds_t out;
+  int16_t vy = shaping_axis((int16_t)(i % 511) - 255);
+  int16_t vx = shaping_axis((int16_t)((i / 511) % 511) - 255);
+  int16_t om = shaping_axis((int16_t)((i * 7) % 511) - 255);
+  shaping_mix_mecanum(vy, vx, om, &out);
+  s_sink = out.fl + out.br;
+}
+
+static void differential_run(uint32_t i) {
+  motor_speeds_t out;
+  int16_t th = shaping_axis((int16_t)(i % 511) - 255);
+  int16_t st = shaping_axis((int16_t)((i / 511) % 511) - 255);
+  shaping_mix_differential(th, st, &out);
+  s_sink = out.fl + out.fr;
+}
+
+// ============================================================
+// TEXT
+// ============================================================
+// One full status line, as the UI draws it every redraw
+static const char s_line[] = "BAT 7.4V  RSSI -61dB";
+
+static void clear_setup(void) {
+  display_clear();
+}
+
+static void text_blit_run(uint32_t i) {
+  display_draw_string(0, (int)(i % 8) * 8 + (int)(i % 3), s_line);
+}
+
+// Baseline: the pixel-at-a-time renderer the blitter replaced
+static void text_pixels_run(uint32_t i) {
+  int x = 0;
+  int y = (int)(i % 8) * 8 + (int)(i % 3);
+  for (const char *c = s_line; *c; c++, x += 6) {
+    int idx = font_index(&font_5x7, *c);
+    const uint8_t *glyph = &font_5x7.bitmap[font_5x7.offset[idx < 0 ? 0 : idx]];
+    for (int col = 0; col < 5; col++) {
+      for (int row = 0; row < 7; row++) {
+        display_set_pixel(x + col, y + row, (glyph[col] >> row) & 1);
+      }
+    }
+  }
+}
+
+// ============================================================
+// FILLS AND LINES
+// ============================================================
+// A 60x20 progress bar at an unaligned row, as the telemetry page draws
+static void fill_run(uint32_t i) {
+  display_fill_rect_mode(4 + (int)(i % 8), 19 + (int)(i % 5), 60, 20,
+                         DRAW_XOR);
+}
+
+// Baseline: the same bar one pixel at a time
+static void fill_pixels_run(uint32_t i) {
+  int x0 = 4 + (int)(i % 8), y0 = 19 + (int)(i % 5);
+  for (int y = y0; y < y0 + 20; y++) {
+    for (int x = x0; x < x0 + 60; x++) {
+      display_set_pixel(x, y, (i & 1) != 0);
+    }
+  }
+}
+
+// Corner to corner, alternating slope
+static void line_run(uint32_t i) {
+  int y = (i & 1) ? 0 : OLED_HEIGHT - 1;
+  display_draw_line(0, y, OLED_WIDTH - 1, OLED_HEIGHT - 1 - y, true);
+}
+
+// ============================================================
+// SCREENS
+// ============================================================
+// Mecanum screen with the joystick connected, as the display task has it
+static void screen_setup(void) {
+  control_setup();
+  g_ctx.movement = MOVEMENT_FORWARD;
+  display_clear();
+  mode_mecanum_draw();
+}
+
+// A stick change: only the changed readout is redrawn, inside its box
+static void screen_refresh_run(uint32_t i) {
+  g_ctx.joystick.throttle = (int16_t)(i % 256);
+  s_sink = mode_mecanum_refresh();
+}
+
+// Baseline: the whole screen redrawn for the same change
+static void screen_redraw_run(uint32_t i) {
+  g_ctx.joystick.throttle = (int16_t)(i % 256);
+  display_clear();
+  mode_mecanum_draw();
+}
+
+// ============================================================
+// PROTOCOL
+// ============================================================
+static const uint8_t s_peer[6] = {0x24, 0x6f, 0x28, 0x00, 0x00, 0x01};
+static proto_joystick_msg_t s_joy_msg;
+static proto_joystick_compact_msg_t s_compact_msg;
+
+static void proto_setup(void) {
+  s_joy_msg.joy = (proto_joystick_t){.throttle = 200, .steering = -40};
+  proto_seal(&s_joy_msg.hdr, PROTO_MSG_JOYSTICK, 1, 1000,
+             sizeof(s_joy_msg.joy));
+  proto_joystick_pack(&s_joy_msg.joy, &s_compact_msg.joy);
+  proto_seal(&s_compact_msg.hdr, PROTO_MSG_JOYSTICK_COMPACT, 1, 1000,
+             sizeof(s_compact_msg.joy));
+}
+
+static void seal_run(uint32_t i) {
+  s_joy_msg.joy.throttle = (int16_t)(i & 0xFF);
+  s_sink = (int32_t)proto_seal(&s_joy_msg.hdr, PROTO_MSG_JOYSTICK,
+                               (uint16_t)i, i, sizeof(s_joy_msg.joy));
+}
+
+static void parse_run(uint32_t i) {
+  const proto_header_t *hdr;
+  (void)i;
+  s_sink = proto_parse((const uint8_t *)&s_joy_msg, sizeof(s_joy_msg), &hdr);
+}
+
+static void parse_compact_run(uint32_t i) {
+  const proto_header_t *hdr;
+  (void)i;
+  s_sink = proto_parse((const uint8_t *)&s_compact_msg, sizeof(s_compact_msg),
+                       &hdr);
+}
+
+static void pack_run(uint32_t i) {
+  proto_joystick_t out;
+  s_joy_msg.joy.steering = (int16_t)(i % 511) - 255;
+  proto_joystick_pack(&s_joy_msg.joy, &s_compact_msg.joy);
+  proto_joystick_unpack(&s_compact_msg.joy, &out);
+  s_sink = out.steering;
+}
+
+static void rx_setup(void) {
+  control_setup();
+  proto_setup();
+}
+
+// Radio callback to g_ctx: validate, dedupe, publish, post, dispatch
+static void rx_run(uint32_t i) {
+  proto_seal(&s_compact_msg.hdr, PROTO_MSG_JOYSTICK_COMPACT, (uint16_t)i,
+             1000, sizeof(s_compact_msg.joy));
+  espnow_handler_receive(s_peer, -50, (const uint8_t *)&s_compact_msg,
+                         sizeof(s_compact_msg));
+  event_bus_dispatch_pending();
+  s_sink = g_ctx.joystick.throttle;
+}
+
+// ============================================================
+// TABLE
+// ============================================================
+static const bench_t s_benches[] = {
+    {"control_step", control_setup, control_run, 200000},
+    {"shaping_axis", NULL, shaping_run, 10000000},
+    {"shape+mix_mecanum", NULL, mecanum_run, 5000000},
+    {"shape+mix_differential", NULL, differential_run, 5000000},
+    {"text_blit", clear_setup, text_blit_run, 1000000},
+    {"text_pixels", clear_setup, text_pixels_run, 200000},
+    {"fill_rect", clear_setup, fill_run, 1000000},
+    {"fill_pixels", clear_setup, fill_pixels_run, 100000},
+    {"draw_line", clear_setup, line_run, 1000000},
+    {"mecanum_refresh", screen_setup, screen_refresh_run, 1000000},
+    {"mecanum_redraw", screen_setup, screen_redraw_run, 200000},
+    {"proto_seal", proto_setup, seal_run, 5000000},
+    {"proto_parse", proto_setup, parse_run, 5000000},
+    {"proto_parse_compact", proto_setup, parse_compact_run, 5000000},
+    {"proto_pack+unpack", proto_setup, pack_run, 10000000},
+    {"rx_compact", rx_setup, rx_run, 1000000},
+};
+
+int main(int argc, char **argv) {
+  const char *filter = (argc > 1) ? argv[1] : "";
+
+  printf("%-24s %10s %10s\n", "benchmark", "iter", "ns/op");
+  for (size_t b = 0; b < sizeof(s_benches) / sizeof(s_benches[0]); b++) {
+    const bench_t *bench = &s_benches[b];
+    if (!strstr(bench->name, filter)) {
+      continue;
+    }
+    if (bench->setup) {
+      bench->setup();
+    }
+
+    // Warm up, then time the whole batch
+    for (uint32_t i = 0; i < bench->iterations / 10; i++) {
+      bench->run(i);
+    }
+    uint64_t start = now_ns();
+    for (uint32_t i = 0; i < bench->iterations; i++) {
+      bench->run(i);
+    }
+    uint64_t elapsed = now_ns() - start;
+
+    printf("%-24s %10lu %10.1f\n", bench->name,
+           (unsigned long)bench->iterations,
+           (double)elapsed / bench->iterations);
+  }
+  return 0;
+}
@@ -0,0 +1,23 @@
+/**
+ * @file buzzer_host.c
+ * @brief Silent buzzer for the host build
+ */
+
+#include "buzzer.h"
+
+void buzzer_init(void) {}
+
+void buzzer_tone(uint16_t freq, uint16_t duration) {
+  (void)freq;
+  (void)duration;
+}
+
+void buzzer_startup(void) {}
+
+void buzzer_click(void) {}
+
+void buzzer_double_click(void) {}
+
+void buzzer_error(void) {}
+
+void buzzer_set_volume(uint8_t volume) { (void)volume; }
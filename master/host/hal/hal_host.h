@@ -0,0 +1,67 @@
+/**
+ * @file hal_host.h
+ * @brief Inspection hooks of the Linux HAL
+ */
+
+#ifndef HAL_HOST_H
+#define HAL_HOST_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Switch hal_time_us() to a simulated clock
+ *
+ * hal_delay_ms() then advances the simulated clock instead of sleeping.
+ *
+ * @param now_us Simulated time, or -1 for the system clock
+ */
+void hal_clock_host_set(int64_t now_us);
+
+/**
+ * @brief Advance the simulated clock
+ * @param us Microseconds
+ */
+void hal_clock_host_advance(int64_t us);
+
+/**
+ * @brief Current level of GPIO0..31 (bit n = GPIOn)
+ */
+uint32_t hal_gpio_host_levels(void);
+
+/**
+ * @brief I2C write sink, called with every transaction
+ * @param addr 7-bit device address
+ * @param data Bytes written
+ * @param len Number of bytes
+ */
+typedef void (*hal_i2c_host_sink_t)(uint8_t addr, const uint8_t *data,
+                                    size_t len);
+
+/**
+ * @brief Route I2C writes to a sink (NULL = discard)
+ * @param sink Sink function
+ */
+void hal_i2c_host_set_sink(hal_i2c_host_sink_t sink);
+
+/**
+ * @brief Total bytes written to the I2C bus
+ */
+uint64_t hal_i2c_host_bytes(void);
+
+/**
+ * @brief Console sink, called with every unit instead of writing stdout
+ * @param data Bytes written
+ * @param len Number of bytes
+ * @return false to drop the unit as if the ring were full
+ */
+typedef bool (*hal_console_host_sink_t)(const uint8_t *data, size_t len);
+
+/**
+ * @brief Route console writes to a sink (NULL = stdout)
+ * @param sink Sink function
+ */
+void hal_console_host_set_sink(hal_console_host_sink_t sink);
+
+#endif // HAL_HOST_H
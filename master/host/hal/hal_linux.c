@@ -0,0 +1,174 @@
+/**
+ * @file hal_linux.c
+ * @brief Linux implementation of the HAL
+ */
+
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "hal_clock.h"
+#include "hal_console.h"
+#include "hal_gpio.h"
+#include "hal_host.h"
+#include "hal_i2c.h"
+#include "hal_queue.h"
+
+static uint32_t s_gpio_levels = 0;
+static hal_i2c_host_sink_t s_i2c_sink = NULL;
+static uint64_t s_i2c_bytes = 0;
+static hal_console_host_sink_t s_console_sink = NULL;
+
+// Simulated clock (tests); negative = monotonic system clock
+static int64_t s_sim_time_us = -1;
+
+// ============================================================
+// CLOCK
+// ============================================================
+int64_t hal_time_us(void) {
+  if (s_sim_time_us >= 0) {
+    return s_sim_time_us;
+  }
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+void hal_delay_ms(uint32_t ms) {
+  if (s_sim_time_us >= 0) {
+    s_sim_time_us += (int64_t)ms * 1000;
+    return;
+  }
+  struct timespec ts = {.tv_sec = ms / 1000,
+                        .tv_nsec = (long)(ms % 1000) * 1000000};
+  nanosleep(&ts, NULL);
+}
+
+void hal_clock_host_set(int64_t now_us) { s_sim_time_us = now_us; }
+
+void hal_clock_host_advance(int64_t us) { s_sim_time_us += us; }
+
+// ============================================================
+// GPIO
+// ============================================================
+void hal_gpio_config_outputs(uint64_t pin_mask) {
+  s_gpio_levels &= ~(uint32_t)pin_mask;
+}
+
+void hal_gpio_write_masks(uint32_t set_mask, uint32_t clr_mask) {
+  s_gpio_levels &= ~clr_mask;
+  s_gpio_levels |= set_mask;
+}
+
+uint32_t hal_gpio_host_levels(void) { return s_gpio_levels; }
+
+// ============================================================
+// I2C
+// ============================================================
+bool hal_i2c_init(int sda, int scl, uint32_t freq_hz) {
+  (void)sda;
+  (void)scl;
+  (void)freq_hz;
+  return true;
+}
+
+bool hal_i2c_write(uint8_t addr, const uint8_t *data, size_t len) {
+  s_i2c_bytes += len;
+  if (s_i2c_sink) {
+    s_i2c_sink(addr, data, len);
+  }
+  return true;
+}
+
+bool hal_i2c_write_async(uint8_t addr, const uint8_t *data, size_t len,
+                         hal_i2c_done_cb_t cb, void *ctx) {
+  // The host bus completes instantly
+  cb(hal_i2c_write(addr, data, len), ctx);
+  return true;
+}
+
+void hal_i2c_host_set_sink(hal_i2c_host_sink_t sink) { s_i2c_sink = sink; }
+
+uint64_t hal_i2c_host_bytes(void) { return s_i2c_bytes; }
+
+// ============================================================
+// CONSOLE
+// ============================================================
+bool hal_console_write(const uint8_t *data, size_t len) {
+  if (len > HAL_CONSOLE_MAX_WRITE) {
+    return false;
+  }
+  if (s_console_sink) {
+    return s_console_sink(data, len);
+  }
+  fwrite(data, 1, len, stdout);
+  fflush(stdout);
+  return true;
+}
+
+void hal_console_host_set_sink(hal_console_host_sink_t sink) {
+  s_console_sink = sink;
+}
+
+// ============================================================
+// QUEUE
+// ============================================================
+struct hal_queue {
+  pthread_mutex_t lock;
+  uint8_t *storage;
+  size_t item_size;
+  size_t length;
+  size_t head; // Items ever sent
+  size_t tail; // Items ever received
+};
+
+static hal_queue_t s_queues[HAL_QUEUE_MAX];
+static int s_queue_count = 0;
+
+hal_queue_t *hal_queue_create(size_t item_size, size_t length,
+                              uint8_t *storage) {
+  if (s_queue_count == HAL_QUEUE_MAX) {
+    return NULL;
+  }
+
+  hal_queue_t *q = &s_queues[s_queue_count++];
+  pthread_mutex_init(&q->lock, NULL);
+  q->storage = storage;
+  q->item_size = item_size;
+  q->length = length;
+  q->head = 0;
+  q->tail = 0;
+  return q;
+}
+
+bool hal_queue_send(hal_queue_t *q, const void *item) {
+  pthread_mutex_lock(&q->lock);
+  bool ok = q->head - q->tail < q->length;
+  if (ok) {
+    memcpy(q->storage + (q->head % q->length) * q->item_size, item,
+           q->item_size);
+    q->head++;
+  }
+  pthread_mutex_unlock(&q->lock);
+  return ok;
+}
+
+bool hal_queue_receive(hal_queue_t *q, void *item) {
+  pthread_mutex_lock(&q->lock);
+  bool ok = q->head != q->tail;
+  if (ok) {
+    memcpy(item, q->storage + (q->tail % q->length) * q->item_size,
+           q->item_size);
+    q->tail++;
+  }
+  pthread_mutex_unlock(&q->lock);
+  return ok;
+}
+
+size_t hal_queue_pending(hal_queue_t *q) {
+  pthread_mutex_lock(&q->lock);
+  size_t n = q->head - q->tail;
+  pthread_mutex_unlock(&q->lock);
+  return n;
+}
@@ -0,0 +1,45 @@
+/**
+ * @file nvs_storage_host.c
+ * @brief In-memory settings storage for the host build
+ *
+ * Loads return the last saved settings, or the firmware defaults before
+ * the first save. Nothing survives the process.
+ */
+
+#include <stdbool.h>
+
+#include "config.h"
+#include "nvs_storage.h"
+
+static settings_data_t s_saved;
+static bool s_has_saved = false;
+
+// ============================================================
+// LOAD SETTINGS
+// ============================================================
+void nvs_storage_load(settings_data_t *settings) {
+  if (s_has_saved) {
+    *settings = s_saved;
+    return;
+  }
+
+  settings->brightness = DEFAULT_BRIGHTNESS;
+  settings->volume = DEFAULT_VOLUME;
+  settings->motor_cal_fl = DEFAULT_MOTOR_CAL;
+  settings->motor_cal_fr = DEFAULT_MOTOR_CAL;
+  settings->motor_cal_bl = DEFAULT_MOTOR_CAL;
+  settings->motor_cal_br = DEFAULT_MOTOR_CAL;
+  for (int i = 0; i < 4; i++) {
+    settings->ramp_accel[i] = DEFAULT_RAMP_ACCEL;
+    settings->ramp_decel[i] = DEFAULT_RAMP_DECEL;
+  }
+  settings->ramp_jerk = DEFAULT_RAMP_JERK;
+}
+
+// ============================================================
+// SAVE SETTINGS
+// ============================================================
+void nvs_storage_save(const settings_data_t *settings) {
+  s_saved = *settings;
+  s_has_saved = true;
+}
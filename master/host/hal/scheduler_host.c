@@ -0,0 +1,91 @@
+/**
+ * @file scheduler_host.c
+ * @brief Rate-group executive for the host build
+ *
+ * Same API as scheduler.c, without a task or timer: groups run from
+ * scheduler_host_run_due(), normally under the simulated clock.
+ */
+
+#include <stdatomic.h>
+
+#include "hal_clock.h"
+#include "hal_host.h"
+#include "hal_log.h"
+#include "scheduler.h"
+#include "scheduler_host.h"
+
+static const char *TAG = "SCHED";
+
+static sched_core_t s_core;
+static atomic_uint s_trigger_mask;
+
+static uint64_t clock_us(void) { return (uint64_t)hal_time_us(); }
+
+// ============================================================
+// PUBLIC API
+// ============================================================
+void scheduler_init(void) {
+  sched_core_init(&s_core, clock_us);
+  atomic_store(&s_trigger_mask, 0);
+}
+
+int scheduler_add_group(const char *name, uint32_t period_us, sched_fn_t fn) {
+  int idx = sched_core_add_group(&s_core, name, period_us, fn);
+  if (idx < 0) {
+    ESP_LOGE(TAG, "Cannot add group %s", name);
+  }
+  return idx;
+}
+
+void scheduler_enable_trigger(int idx, uint32_t min_gap_us) {
+  sched_core_set_trigger(&s_core, idx, min_gap_us);
+}
+
+void scheduler_trigger(int idx) {
+  if (idx < 0 || idx >= SCHED_MAX_GROUPS) {
+    return;
+  }
+  atomic_fetch_or(&s_trigger_mask, 1u << idx);
+}
+
+void scheduler_start(void) { sched_core_start(&s_core, clock_us()); }
+
+bool scheduler_get_stats(int idx, sched_stats_t *out) {
+  return sched_core_get_stats(&s_core, idx, out);
+}
+
+void scheduler_log_stats(void) {
+  sched_stats_t st;
+  for (int i = 0; sched_core_get_stats(&s_core, i, &st); i++) {
+    ESP_LOGI(TAG, "%-8s %5lu us: runs=%lu trig=%lu miss=%lu", st.name,
+             (unsigned long)st.period_us, (unsigned long)st.runs,
+             (unsigned long)st.triggered_runs,
+             (unsigned long)st.deadline_misses);
+  }
+}
+
+// ============================================================
+// HOST EXECUTIVE
+// ============================================================
+uint64_t scheduler_host_run_due(void) {
+  uint32_t mask = atomic_exchange(&s_trigger_mask, 0);
+  for (int i = 0; mask; i++, mask >>= 1) {
+    if (mask & 1) {
+      sched_core_trigger(&s_core, i);
+    }
+  }
+  return sched_core_run_due(&s_core, clock_us());
+}
+
+void scheduler_host_run_until(uint64_t until_us) {
+  uint64_t next = scheduler_host_run_due();
+  while (next <= until_us) {
+    if (next > clock_us()) {
+      hal_clock_host_set((int64_t)next);
+    }
+    next = scheduler_host_run_due();
+  }
+  if (until_us > clock_us()) {
+    hal_clock_host_set((int64_t)until_us);
+  }
+}
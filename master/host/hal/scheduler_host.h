@@ -0,0 +1,24 @@
+/**
+ * @file scheduler_host.h
+ * @brief Host executive: groups run when the test or tool asks
+ */
+
+#ifndef SCHEDULER_HOST_H
+#define SCHEDULER_HOST_H
+
+#include <stdint.h>
+
+/**
+ * @brief Run triggered groups and every group due at hal_time_us()
+ * @return Earliest pending release time in microseconds
+ */
+uint64_t scheduler_host_run_due(void);
+
+/**
+ * @brief Advance the simulated clock to @p until_us, running groups at each
+ *        release on the way
+ * @param until_us End time in microseconds
+ */
+void scheduler_host_run_until(uint64_t until_us);
+
+#endif // SCHEDULER_HOST_H
@@ -0,0 +1,8 @@
+/**
+ * @file host_context.c
+ * @brief Firmware globals that main.c owns on target
+ */
+
+#include "types.h"
+
+system_context_t g_ctx = {0};
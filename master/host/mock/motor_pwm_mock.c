@@ -0,0 +1,64 @@
+/**
+ * @file motor_pwm_mock.c
+ * @brief Host mock of the motor PWM backend
+ */
+
+#include <string.h>
+
+#include "hal_host.h"
+#include "motor_pwm.h"
+#include "motor_pwm_mock.h"
+
+static uint32_t s_staged[4];
+static uint8_t s_cut = 0; // Wheels held low until their next set_duty
+static motor_pwm_sample_t s_timeline[MOTOR_PWM_MOCK_SAMPLES];
+static size_t s_count = 0;
+static int64_t s_now_us = 0;
+
+static void record(void) {
+  if (s_count >= MOTOR_PWM_MOCK_SAMPLES) {
+    return;
+  }
+  motor_pwm_sample_t *s = &s_timeline[s_count++];
+  s->t_us = s_now_us;
+  for (int i = 0; i < 4; i++) {
+    s->duty[i] = (s_cut & (1U << i)) ? 0 : s_staged[i];
+  }
+  s->gpio = hal_gpio_host_levels();
+}
+
+// ============================================================
+// BACKEND
+// ============================================================
+void motor_pwm_init(void) { motor_pwm_mock_reset(); }
+
+void motor_pwm_set_duty(int wheel, uint32_t duty) {
+  s_staged[wheel] = duty;
+  s_cut &= (uint8_t)~(1U << wheel);
+}
+
+void motor_pwm_latch(void) { record(); }
+
+// Visible at once: recorded as a sample of its own
+void motor_pwm_cut(int wheel) {
+  s_cut |= (uint8_t)(1U << wheel);
+  record();
+}
+
+// ============================================================
+// MOCK CONTROL
+// ============================================================
+void motor_pwm_mock_reset(void) {
+  memset(s_staged, 0, sizeof(s_staged));
+  s_cut = 0;
+  s_count = 0;
+  s_now_us = 0;
+}
+
+void motor_pwm_mock_set_time(int64_t t_us) { s_now_us = t_us; }
+
+size_t motor_pwm_mock_count(void) { return s_count; }
+
+const motor_pwm_sample_t *motor_pwm_mock_sample(size_t idx) {
+  return (idx < s_count) ? &s_timeline[idx] : NULL;
+}
@@ -0,0 +1,50 @@
+/**
+ * @file motor_pwm_mock.h
+ * @brief Host mock of the motor PWM backend
+ *
+ * Implements motor_pwm.h and records every latch and every cut as one
+ * timeline sample, so host code can check what duties reached the wheels,
+ * through which direction pins, and when.
+ */
+
+#ifndef MOTOR_PWM_MOCK_H
+#define MOTOR_PWM_MOCK_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define MOTOR_PWM_MOCK_SAMPLES 1024
+
+/**
+ * @brief Duties visible on the four wheels after one latch
+ */
+typedef struct {
+  int64_t t_us;     // Mock time of the latch
+  uint32_t duty[4]; // FL, FR, BL, BR in backend ticks
+  uint32_t gpio;    // GPIO0..31 levels (direction pins) at the latch
+} motor_pwm_sample_t;
+
+/**
+ * @brief Clear the timeline and all duties
+ */
+void motor_pwm_mock_reset(void);
+
+/**
+ * @brief Set the time stamped on following latches
+ * @param t_us Time in microseconds
+ */
+void motor_pwm_mock_set_time(int64_t t_us);
+
+/**
+ * @brief Number of recorded samples (saturates at MOTOR_PWM_MOCK_SAMPLES)
+ */
+size_t motor_pwm_mock_count(void);
+
+/**
+ * @brief Get one recorded sample
+ * @param idx Sample index, oldest first
+ * @return Sample, or NULL if idx is out of range
+ */
+const motor_pwm_sample_t *motor_pwm_mock_sample(size_t idx);
+
+#endif // MOTOR_PWM_MOCK_H
@@ -0,0 +1,198 @@
+/**
+ * @file ref_display.h
+ * @brief Naive one-pixel-at-a-time renderer, the reference for display.c
+ *
+ * Every primitive here walks pixels with an explicit bounds check, the way
+ * the driver did before it worked on page bytes. Tests draw the same
+ * sequence into both and compare the result through display_get_pbm().
+ */
+
+#ifndef REF_DISPLAY_H
+#define REF_DISPLAY_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "config.h"
+#include "display.h"
+#include "font.h"
+#include "ui_common.h"
+
+typedef struct {
+  bool px[OLED_HEIGHT][OLED_WIDTH];
+} ref_fb_t;
+
+static inline void ref_clear(ref_fb_t *fb) { memset(fb, 0, sizeof(*fb)); }
+
+static inline void ref_plot(ref_fb_t *fb, int x, int y, draw_mode_t mode) {
+  if (x < 0 || x >= OLED_WIDTH || y < 0 || y >= OLED_HEIGHT) {
+    return;
+  }
+  switch (mode) {
+  case DRAW_SET:
+    fb->px[y][x] = true;
+    break;
+  case DRAW_CLEAR:
+    fb->px[y][x] = false;
+    break;
+  case DRAW_XOR:
+    fb->px[y][x] = !fb->px[y][x];
+    break;
+  }
+}
+
+// Column bytes, LSB = top row, h <= 8
+static inline void ref_blit_columns(ref_fb_t *fb, int x, int y,
+                                    const uint8_t *cols, int w, int h,
+                                    draw_mode_t mode) {
+  for (int c = 0; c < w; c++) {
+    for (int r = 0; r < h && r < 8; r++) {
+      if (cols[c] & (1 << r)) {
+        ref_plot(fb, x + c, y + r, mode);
+      }
+    }
+  }
+}
+
+// Page-organised bitmap: ceil(h / 8) bands of w column bytes
+static inline void ref_blit(ref_fb_t *fb, int x, int y, const uint8_t *bitmap,
+                            int w, int h, draw_mode_t mode) {
+  for (int r = 0; r < h; r++) {
+    for (int c = 0; c < w; c++) {
+      if (bitmap[(r / 8) * w + c] & (1 << (r % 8))) {
+        ref_plot(fb, x + c, y + r, mode);
+      }
+    }
+  }
+}
+
+static inline const uint8_t *ref_glyph(const font_t *font, char c, int *w) {
+  int i = font_index(font, c);
+  if (i < 0) {
+    i = font_index(font, ' ');
+  }
+  if (i < 0) {
+    return NULL;
+  }
+  *w = font->width[i];
+  return &font->bitmap[font->offset[i]];
+}
+
+// Opaque 5x7 cell
+static inline void ref_draw_char(ref_fb_t *fb, int x, int y, char c) {
+  int w;
+  const uint8_t *g = ref_glyph(&font_5x7, c, &w);
+  for (int col = 0; col < 5; col++) {
+    for (int r = 0; r < 7; r++) {
+      ref_plot(fb, x + col, y + r, (g[col] & (1 << r)) ? DRAW_SET : DRAW_CLEAR);
+    }
+  }
+}
+
+static inline void ref_draw_string(ref_fb_t *fb, int x, int y,
+                                   const char *s) {
+  for (; *s; s++, x += 6) {
+    ref_draw_char(fb, x, y, *s);
+  }
+}
+
+static inline int ref_draw_text(ref_fb_t *fb, int x, int y, const char *s,
+                                const font_t *font, draw_mode_t mode) {
+  for (; *s; s++) {
+    int w;
+    const uint8_t *g = ref_glyph(font, *s, &w);
+    if (!g) {
+      continue;
+    }
+    ref_blit(fb, x, y, g, w, font->height, mode);
+    x += w + font->spacing;
+  }
+  return x;
+}
+
+static inline void ref_fill_rect(ref_fb_t *fb, int x, int y, int w, int h,
+                                 draw_mode_t mode) {
+  for (int r = y; r < y + h; r++) {
+    for (int c = x; c < x + w; c++) {
+      ref_plot(fb, c, r, mode);
+    }
+  }
+}
+
+static inline void ref_rect(ref_fb_t *fb, int x, int y, int w, int h) {
+  if (w <= 0 || h <= 0) {
+    return;
+  }
+  for (int c = x; c < x + w; c++) {
+    ref_plot(fb, c, y, DRAW_SET);
+    ref_plot(fb, c, y + h - 1, DRAW_SET);
+  }
+  for (int r = y; r < y + h; r++) {
+    ref_plot(fb, x, r, DRAW_SET);
+    ref_plot(fb, x + w - 1, r, DRAW_SET);
+  }
+}
+
+// n / d rounded to nearest, halves away from zero; d > 0
+static inline int ref_round_div(int n, int d) {
+  return (n >= 0) ? (2 * n + d) / (2 * d) : -((-2 * n + d) / (2 * d));
+}
+
+// One pixel per step along the major axis, the minor coordinate taken
+// from the exact line and rounded; ties go toward the far end
+static inline void ref_line(ref_fb_t *fb, int x0, int y0, int x1, int y1,
+                            bool on) {
+  int dx = x1 - x0, dy = y1 - y0;
+  int adx = dx < 0 ? -dx : dx, ady = dy < 0 ? -dy : dy;
+  draw_mode_t mode = on ? DRAW_SET : DRAW_CLEAR;
+
+  if (adx == 0 && ady == 0) {
+    ref_plot(fb, x0, y0, mode);
+  } else if (adx >= ady) {
+    for (int i = 0; i <= adx; i++) {
+      ref_plot(fb, x0 + (dx < 0 ? -i : i), y0 + ref_round_div(i * dy, adx),
+               mode);
+    }
+  } else {
+    for (int i = 0; i <= ady; i++) {
+      ref_plot(fb, x0 + ref_round_div(i * dx, ady), y0 + (dy < 0 ? -i : i),
+               mode);
+    }
+  }
+}
+
+// Pixels that differ between the reference and the driver's framebuffer
+static inline int ref_mismatches(const ref_fb_t *fb) {
+  static uint8_t pbm[DISPLAY_PBM_MAX_BYTES];
+  size_t n = display_get_pbm(pbm, sizeof(pbm));
+  size_t hdr = n - OLED_WIDTH * OLED_HEIGHT / 8;
+
+  int bad = 0;
+  for (int y = 0; y < OLED_HEIGHT; y++) {
+    for (int x = 0; x < OLED_WIDTH; x++) {
+      bool on = (pbm[hdr + y * (OLED_WIDTH / 8) + x / 8] >> (7 - x % 8)) & 1;
+      if (on != fb->px[y][x]) {
+        bad++;
+      }
+    }
+  }
+  return bad;
+}
+
+// Deterministic pseudo-random numbers (xorshift32)
+static uint32_t s_ref_rng = 0x12345678u;
+
+static inline uint32_t ref_rand(void) {
+  s_ref_rng ^= s_ref_rng << 13;
+  s_ref_rng ^= s_ref_rng >> 17;
+  s_ref_rng ^= s_ref_rng << 5;
+  return s_ref_rng;
+}
+
+// Uniform in [lo, hi]
+static inline int ref_rand_range(int lo, int hi) {
+  return lo + (int)(ref_rand() % (uint32_t)(hi - lo + 1));
+}
+
+#endif // REF_DISPLAY_H
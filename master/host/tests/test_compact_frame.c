@@ -0,0 +1,133 @@
+/**
+ * @file test_compact_frame.c
+ * @brief Compact joystick frame: lossless axes, same wheel duties
+ *
+ * The 9-bit fields must carry every stick value the remote can send, and
+ * the wheels must see at most one PWM step of difference between a
+ * compact frame and the full one (in practice none).
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "drive_shaping.h"
+#include "espnow_handler.h"
+#include "event_bus.h"
+#include "input_snapshot.h"
+#include "protocol.h"
+#include "test_util.h"
+
+static const uint8_t s_peer[6] = {0x24, 0x6f, 0x28, 0x00, 0x00, 0x03};
+
+static proto_joystick_t round_trip(const proto_joystick_t *in) {
+  proto_joystick_compact_t packed;
+  proto_joystick_t out;
+  proto_joystick_pack(in, &packed);
+  proto_joystick_unpack(&packed, &out);
+  return out;
+}
+
+static void mecanum_duties(const proto_joystick_t *j, motor_speeds_t *out) {
+  shaping_mix_mecanum(shaping_axis(j->throttle), shaping_axis(j->steering),
+                      shaping_axis(j->aux_x), out);
+}
+
+static int duty_error(const motor_speeds_t *a, const motor_speeds_t *b) {
+  const int d[4] = {abs(a->fl - b->fl), abs(a->fr - b->fr),
+                    abs(a->bl - b->bl), abs(a->br - b->br)};
+  int worst = 0;
+  for (int i = 0; i < 4; i++) {
+    worst = d[i] > worst ? d[i] : worst;
+  }
+  return worst;
+}
+
+// Every axis value on every field, with every button and mode
+static void test_fields_exact(void) {
+  int mismatches = 0;
+  for (int v = -PROTO_AXIS_BIAS; v <= PROTO_AXIS_BIAS; v++) {
+    for (int field = 0; field < 4; field++) {
+      for (int flags = 0; flags < 16; flags++) {
+        int16_t axes[4] = {7, -7, 100, -100};
+        axes[field] = (int16_t)v;
+        proto_joystick_t in = {
+            .throttle = axes[0],
+            .steering = axes[1],
+            .aux_x = axes[2],
+            .aux_y = axes[3],
+            .buttons = (uint8_t)(flags & 0x03),
+            .mode = (uint8_t)(flags >> 2),
+        };
+        proto_joystick_t out = round_trip(&in);
+        mismatches += memcmp(&in, &out, sizeof(in)) != 0;
+      }
+    }
+  }
+  CHECK_EQ(mismatches, 0);
+}
+
+// Quantisation error at the wheels over the whole stick grid, past the
+// ends too: values beyond +/-255 clamp exactly as shaping_axis() does
+static void test_duty_error(void) {
+  int worst = 0;
+  for (int th = -300; th <= 300; th++) {
+    for (int st = -300; st <= 300; st += 3) {
+      proto_joystick_t full = {
+          .throttle = (int16_t)th,
+          .steering = (int16_t)st,
+          .aux_x = (int16_t)((th * 7 + st) % 301),
+      };
+      proto_joystick_t compact = round_trip(&full);
+      motor_speeds_t a, b;
+      mecanum_duties(&full, &a);
+      mecanum_duties(&compact, &b);
+      int e = duty_error(&a, &b);
+      worst = e > worst ? e : worst;
+    }
+  }
+  // Within one PWM step is the requirement; the 9-bit fields make it exact
+  CHECK_EQ(worst, 0);
+}
+
+// The receiver publishes the same frame for either format
+static void test_receive_both_formats(void) {
+  proto_joystick_msg_t full = {
+      .joy = {.throttle = -201,
+              .steering = 255,
+              .aux_x = -255,
+              .aux_y = 3,
+              .buttons = PROTO_BTN2,
+              .mode = 2},
+  };
+  proto_joystick_compact_msg_t compact;
+  proto_joystick_pack(&full.joy, &compact.joy);
+
+  event_bus_init();
+  joystick_frame_t a, b;
+  size_t len = proto_seal(&full.hdr, PROTO_MSG_JOYSTICK, 10, 100,
+                          sizeof(full.joy));
+  espnow_handler_receive(s_peer, -50, (const uint8_t *)&full, (int)len);
+  CHECK(input_snapshot_read_joystick(&a));
+
+  len = proto_seal(&compact.hdr, PROTO_MSG_JOYSTICK_COMPACT, 11, 110,
+                   sizeof(compact.joy));
+  CHECK_EQ(len, sizeof(proto_header_t) + 5);
+  espnow_handler_receive(s_peer, -50, (const uint8_t *)&compact, (int)len);
+  CHECK(input_snapshot_read_joystick(&b));
+
+  CHECK_EQ(b.count, a.count + 1);
+  CHECK_EQ(b.data.throttle, a.data.throttle);
+  CHECK_EQ(b.data.steering, a.data.steering);
+  CHECK_EQ(b.data.aux_x, a.data.aux_x);
+  CHECK_EQ(b.data.aux_y, a.data.aux_y);
+  CHECK_EQ(b.data.btn1, a.data.btn1);
+  CHECK_EQ(b.data.btn2, a.data.btn2);
+  CHECK_EQ(b.data.mode, a.data.mode);
+}
+
+int main(void) {
+  test_fields_exact();
+  test_duty_error();
+  test_receive_both_formats();
+  return TEST_RESULT();
+}
@@ -0,0 +1,333 @@
+/**
+ * @file test_control_path.c
+ * @brief Radio packet -> event bus -> FSM -> mode -> motor PWM, end to end
+ *
+ * Runs the real receive path, dispatcher and control group under the host
+ * executive and the simulated clock, and checks the duties latched by the
+ * PWM mock. Also built with CONTROL_INPUT_TRIGGERED=1 (test_control_path_
+ * triggered), where packets release the group and a slow tick remains.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "config.h"
+#include "control.h"
+#include "espnow_handler.h"
+#include "event_bus.h"
+#include "fsm.h"
+#include "hal_clock.h"
+#include "hal_host.h"
+#include "motor.h"
+#include "motor_ramp.h"
+#include "motor_pwm_mock.h"
+#include "protocol.h"
+#include "scheduler.h"
+#include "scheduler_host.h"
+#include "test_util.h"
+#include "types.h"
+
+// Period of the control group's own releases
+#if CONTROL_INPUT_TRIGGERED
+#define CONTROL_TICK_MS CONTROL_FALLBACK_MS
+#else
+#define CONTROL_TICK_MS CONTROL_PERIOD_MS
+#endif
+
+static const uint8_t s_peer[6] = {0x24, 0x6f, 0x28, 0x00, 0x00, 0x01};
+static uint16_t s_seq = 0;
+
+static void send_joystick(int16_t throttle, int16_t steering, bool btn1) {
+  proto_joystick_msg_t msg = {
+      .joy = {.throttle = throttle,
+              .steering = steering,
+              .buttons = btn1 ? PROTO_BTN1 : 0},
+  };
+  size_t len = proto_seal(&msg.hdr, PROTO_MSG_JOYSTICK, s_seq++,
+                          (uint32_t)(hal_time_us() / 1000), sizeof(msg.joy));
+  espnow_handler_receive(s_peer, -50, (const uint8_t *)&msg, (int)len);
+}
+
+static const motor_pwm_sample_t *last_sample(void) {
+  size_t n = motor_pwm_mock_count();
+  return n ? motor_pwm_mock_sample(n - 1) : NULL;
+}
+
+static void setup(void) {
+  hal_clock_host_set(1000000);
+  memset(&g_ctx, 0, sizeof(g_ctx));
+  motor_pwm_mock_reset();
+  motor_init();
+  motor_set_calibration(255, 255, 255, 255);
+
+  event_bus_init();
+  fsm_init();
+  scheduler_init();
+  control_init();
+  scheduler_start();
+  event_bus_post_state(STATE_MODE_MECANUM);
+}
+
+static void test_forward_reaches_wheels(void) {
+  setup();
+  send_joystick(255, 0, false);
+  scheduler_host_run_until(hal_time_us() + 50000);
+
+  CHECK(g_ctx.joystick_connected);
+  CHECK_EQ(g_ctx.current_state, STATE_MODE_MECANUM);
+  CHECK_EQ(g_ctx.movement, MOVEMENT_FORWARD);
+
+  const motor_pwm_sample_t *s = last_sample();
+  CHECK(s != NULL);
+  if (s) {
+    for (int i = 0; i < 4; i++) {
+      CHECK_EQ(s->duty[i], MOTOR_PWM_MAX_DUTY);
+    }
+  }
+
+  // Control group ran at its period; every frame was measured
+  sched_stats_t st;
+  CHECK(scheduler_get_stats(0, &st));
+  CHECK(st.runs >= 50000 / (CONTROL_TICK_MS * 1000));
+  CHECK_EQ(control_get_latency()->count, 1);
+}
+
+static void test_link_timeout_stops(void) {
+  setup();
+  send_joystick(255, 0, false);
+  scheduler_host_run_until(hal_time_us() + 20000);
+
+  // No packets: past the timeout the wheels stop
+  scheduler_host_run_until(hal_time_us() +
+                           (CONNECTION_TIMEOUT_MS + 20) * 1000);
+  CHECK(!g_ctx.joystick_connected);
+  const motor_pwm_sample_t *s = last_sample();
+  CHECK(s != NULL);
+  if (s) {
+    for (int i = 0; i < 4; i++) {
+      CHECK_EQ(s->duty[i], 0);
+    }
+  }
+}
+
+static void test_emergency_button(void) {
+  setup();
+  send_joystick(255, 0, false);
+  scheduler_host_run_until(hal_time_us() + 20000);
+  send_joystick(255, 0, true);
+  scheduler_host_run_until(hal_time_us() + 20000);
+
+  CHECK_EQ(g_ctx.movement, MOVEMENT_EMERGENCY);
+  CHECK(g_ctx.estop_latched);
+  const motor_pwm_sample_t *s = last_sample();
+  CHECK(s != NULL);
+  if (s) {
+    CHECK_EQ(s->duty[0], 0);
+  }
+}
+
+static bool wheels_stopped(void) {
+  const motor_pwm_sample_t *s = last_sample();
+  return s && s->duty[0] == 0 && s->duty[1] == 0 && s->duty[2] == 0 &&
+         s->duty[3] == 0;
+}
+
+// Releasing the stop button with the stick still pushed must not restart
+// the wheels; only a pass through neutral does
+static void test_estop_holds_until_neutral(void) {
+  setup();
+  send_joystick(255, 0, false);
+  scheduler_host_run_until(hal_time_us() + 20000);
+  send_joystick(255, 0, true);
+  scheduler_host_run_until(hal_time_us() + 20000);
+  send_joystick(255, 0, false);
+  scheduler_host_run_until(hal_time_us() + 50000);
+
+  CHECK(g_ctx.estop_latched);
+  CHECK_EQ(g_ctx.movement, MOVEMENT_EMERGENCY);
+  CHECK(wheels_stopped());
+
+  send_joystick(0, 0, false);
+  scheduler_host_run_until(hal_time_us() + 20000);
+  CHECK(!g_ctx.estop_latched);
+  CHECK_EQ(g_ctx.movement, MOVEMENT_STOP);
+
+  send_joystick(255, 0, false);
+  scheduler_host_run_until(hal_time_us() + 50000);
+  CHECK_EQ(g_ctx.movement, MOVEMENT_FORWARD);
+  CHECK(!wheels_stopped());
+}
+
+// The OK long press latches the same way; the next cycle keeps it
+static void test_estop_button_latches(void) {
+  setup();
+  send_joystick(255, 0, false);
+  scheduler_host_run_until(hal_time_us() + 20000);
+  event_bus_post_button(BTN_EVT_OK_LONG);
+  send_joystick(255, 0, false);
+  scheduler_host_run_until(hal_time_us() + 50000);
+
+  CHECK(g_ctx.estop_latched);
+  CHECK_EQ(g_ctx.movement, MOVEMENT_EMERGENCY);
+  CHECK(wheels_stopped());
+}
+
+// OK long with the stick already centred: staying at neutral is not a
+// release; only moving the stick and re-centring it is
+static void test_estop_neutral_stick(void) {
+  setup();
+  send_joystick(0, 0, false);
+  scheduler_host_run_until(hal_time_us() + 20000);
+  event_bus_post_button(BTN_EVT_OK_LONG);
+  for (int i = 0; i < 10; i++) {
+    send_joystick(0, 0, false);
+    scheduler_host_run_until(hal_time_us() + 20000);
+  }
+  CHECK(g_ctx.estop_latched);
+  CHECK_EQ(g_ctx.movement, MOVEMENT_EMERGENCY);
+
+  send_joystick(255, 0, false);
+  scheduler_host_run_until(hal_time_us() + 20000);
+  CHECK(g_ctx.estop_latched);
+  CHECK(wheels_stopped());
+
+  send_joystick(0, 0, false);
+  scheduler_host_run_until(hal_time_us() + 20000);
+  CHECK(!g_ctx.estop_latched);
+  CHECK_EQ(g_ctx.movement, MOVEMENT_STOP);
+
+  send_joystick(255, 0, false);
+  scheduler_host_run_until(hal_time_us() + 50000);
+  CHECK_EQ(g_ctx.movement, MOVEMENT_FORWARD);
+}
+
+// The applied speeds (telemetry) follow the ramp, not the mode's targets,
+// and drop to zero with an emergency stop
+static void test_applied_speeds(void) {
+  setup();
+  for (int i = 0; i < 4; i++) {
+    g_ctx.settings.ramp_accel[i] = 1000; // Duty per second
+  }
+  motor_ramp_configure(&g_ctx.settings);
+
+  send_joystick(255, 0, false);
+  scheduler_host_run_until(hal_time_us() + 50000);
+  motor_speeds_t out;
+  motor_get_applied(&out);
+  CHECK_EQ(g_ctx.motor_speeds.fl, MAX_SPEED);
+  CHECK(out.fl > 0 && out.fl < MAX_SPEED / 2);
+
+  send_joystick(255, 0, true);
+  scheduler_host_run_until(hal_time_us() + 10000);
+  motor_get_applied(&out);
+  CHECK_EQ(out.fl, 0);
+  CHECK_EQ(out.br, 0);
+
+  g_ctx.settings = (settings_data_t){0};
+  motor_ramp_configure(&g_ctx.settings);
+}
+
+// New duties reach the pins only at the PWM period end: the pins may
+// select a new direction only under a wheel whose visible duty is already
+// zero (clearing both pins to coast is always safe)
+static void test_reversal_cuts_first(void) {
+  static const uint32_t pins[4] = {
+      (1UL << PIN_FL_IN1) | (1UL << PIN_FL_IN2),
+      (1UL << PIN_FR_IN1) | (1UL << PIN_FR_IN2),
+      (1UL << PIN_BL_IN1) | (1UL << PIN_BL_IN2),
+      (1UL << PIN_BR_IN1) | (1UL << PIN_BR_IN2),
+  };
+  const motor_speeds_t fwd = {200, -200, 150, 0};
+  const motor_speeds_t rev = {-200, 200, 150, 0};
+
+  setup();
+  motor_pwm_mock_reset();
+  motor_apply_speeds(&fwd);
+  motor_apply_speeds(&rev);
+  motor_apply_speeds(&fwd);
+  motor_stop_all();
+
+  int unsafe = 0;
+  size_t n = motor_pwm_mock_count();
+  for (size_t k = 1; k < n; k++) {
+    const motor_pwm_sample_t *prev = motor_pwm_mock_sample(k - 1);
+    const motor_pwm_sample_t *cur = motor_pwm_mock_sample(k);
+    for (int i = 0; i < 4; i++) {
+      uint32_t was = prev->gpio & pins[i], now = cur->gpio & pins[i];
+      unsafe += now && now != was && prev->duty[i] != 0;
+    }
+  }
+  CHECK_EQ(unsafe, 0);
+  CHECK_EQ(n, 8); // Two wheels reverse twice: a cut each, then the latch
+  if (n == 8) {
+    // The cut wheels drive again once their new duty latches
+    CHECK(motor_pwm_mock_sample(0)->duty[0] > 0);
+    CHECK_EQ(motor_pwm_mock_sample(3)->duty[0],
+             motor_pwm_mock_sample(0)->duty[0]);
+    CHECK_EQ(motor_pwm_mock_sample(6)->duty[1],
+             motor_pwm_mock_sample(0)->duty[1]);
+  }
+}
+
+static void test_duplicate_ignored(void) {
+  setup();
+  send_joystick(100, 0, false);
+  s_seq--; // Retransmission of the same message
+  send_joystick(100, 0, false);
+  scheduler_host_run_until(hal_time_us() + 10000);
+
+  event_bus_stats_t ev;
+  event_bus_get_stats(&ev);
+  CHECK_EQ(control_get_latency()->count, 1);
+  CHECK_EQ(ev.dropped, 0);
+}
+
+// Frames land at every phase of the control period. Polled, they wait
+// half a period on median; triggered, they run at once (the packets are
+// further apart than CONTROL_MIN_GAP_US)
+static void test_input_latency(void) {
+  setup();
+  for (int i = 0; i < 200; i++) {
+    send_joystick(100, 0, false);
+    scheduler_host_run_until(hal_time_us() + 7300);
+  }
+
+  const latency_hist_t *h = control_get_latency();
+  uint32_t p50 = latency_hist_percentile(h, 50);
+  printf("radio->PWM p50 %lu us over %lu frames (%s)\n", (unsigned long)p50,
+         (unsigned long)h->count,
+         CONTROL_INPUT_TRIGGERED ? "input-triggered" : "periodic");
+  CHECK_EQ(h->count, 200);
+#if CONTROL_INPUT_TRIGGERED
+  CHECK(p50 <= CONTROL_MIN_GAP_US);
+#else
+  CHECK(p50 >= CONTROL_PERIOD_MS * 1000 / 4);
+#endif
+}
+
+// Without input the group still runs on its own tick, which serves the
+// link timeout
+static void test_runs_without_input(void) {
+  setup();
+  scheduler_host_run_until(hal_time_us() + 200000);
+
+  sched_stats_t st;
+  CHECK(scheduler_get_stats(0, &st));
+  CHECK(st.runs >= 200000 / (CONTROL_TICK_MS * 1000));
+  CHECK_EQ(st.triggered_runs, 0);
+}
+
+int main(void) {
+  test_forward_reaches_wheels();
+  test_link_timeout_stops();
+  test_emergency_button();
+  test_estop_holds_until_neutral();
+  test_estop_button_latches();
+  test_estop_neutral_stick();
+  test_applied_speeds();
+  test_reversal_cuts_first();
+  test_duplicate_ignored();
+  test_input_latency();
+  test_runs_without_input();
+  return TEST_RESULT();
+}
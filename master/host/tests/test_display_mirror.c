@@ -0,0 +1,188 @@
+/**
+ * @file test_display_mirror.c
+ * @brief Mirror frames decode to the framebuffer and stay within bounds
+ *
+ * Frames are captured from the console sink and decoded the way
+ * tools/oled_mirror.py does, including the densest run mixes and frames
+ * the console drops.
+ */
+
+#include <string.h>
+
+#include "config.h"
+#include "display_mirror.h"
+#include "hal_console.h"
+#include "hal_host.h"
+#include "ref_display.h"
+#include "test_util.h"
+
+#define PAGES (OLED_HEIGHT / 8)
+#define FB_BYTES (OLED_WIDTH * PAGES)
+#define FRAME_MAX (6 + PAGES * (OLED_WIDTH + 1) + 1)
+
+static uint8_t s_viewer[FB_BYTES]; // What the viewer shows
+static int s_frames = 0;
+static int s_keyframes = 0;
+static size_t s_largest = 0;
+static bool s_accept = true;
+static int s_bad = 0;
+
+// Decodes one frame into s_viewer; counts malformed frames in s_bad
+static bool sink(const uint8_t *f, size_t len) {
+  if (!s_accept) {
+    return false;
+  }
+  s_frames++;
+  if (len > s_largest) {
+    s_largest = len;
+  }
+
+  if (len < 7) {
+    s_bad++;
+    return true;
+  }
+  size_t plen = (size_t)f[4] | ((size_t)f[5] << 8);
+  uint8_t sum = 0;
+  for (size_t i = 2; i < len - 1; i++) {
+    sum += f[i];
+  }
+  if (f[0] != 0xA5 || f[1] != 0x5A || plen != len - 7 || sum != f[len - 1]) {
+    s_bad++;
+    return true;
+  }
+
+  bool key = f[2] & 0x01;
+  if (key) {
+    s_keyframes++;
+    memset(s_viewer, 0, sizeof(s_viewer));
+  }
+
+  const uint8_t *p = &f[6], *end = &f[6 + plen];
+  for (int page = 0; page < PAGES; page++) {
+    if (!(f[3] & (1 << page))) {
+      continue;
+    }
+    uint8_t *row = &s_viewer[page * OLED_WIDTH];
+    int x = 0;
+    while (x < OLED_WIDTH && p < end) {
+      uint8_t tok = *p++;
+      int n = (tok & 0x7F) + 1;
+      if (x + n > OLED_WIDTH) {
+        s_bad++;
+        return true;
+      }
+      if (tok & 0x80) {
+        for (int i = 0; i < n && p < end; i++) {
+          row[x++] ^= *p++;
+        }
+      } else {
+        x += n;
+      }
+    }
+    if (x != OLED_WIDTH) {
+      s_bad++;
+      return true;
+    }
+  }
+  if (p != end) {
+    s_bad++;
+  }
+  return true;
+}
+
+static void fill_pattern(uint8_t *fb, int kind) {
+  for (int i = 0; i < FB_BYTES; i++) {
+    switch (kind) {
+    case 0: // Alternating zero and literal columns: the densest RLE
+      fb[i] = (i & 1) ? 0xFF : 0x00;
+      break;
+    case 1: // Pairs of literals between single zeros
+      fb[i] = (i % 3) ? 0xAA : 0x00;
+      break;
+    case 2: // All literal
+      fb[i] = 0x55;
+      break;
+    default:
+      fb[i] = (ref_rand() % 4 == 0) ? (uint8_t)ref_rand() : 0;
+      break;
+    }
+  }
+}
+
+static void setup(void) {
+  memset(s_viewer, 0xEE, sizeof(s_viewer)); // Garbage until a keyframe
+  s_frames = s_keyframes = s_bad = 0;
+  s_largest = 0;
+  s_accept = true;
+  hal_console_host_set_sink(sink);
+}
+
+// Keyframes of the worst patterns: bounded frame, exact image
+static void test_dense_keyframes(void) {
+  static uint8_t fb[FB_BYTES];
+  for (int kind = 0; kind < 4; kind++) {
+    setup();
+    fill_pattern(fb, kind);
+    display_mirror_send(fb, NULL, 0, PAGES - 1);
+    CHECK_EQ(s_frames, 1);
+    CHECK_EQ(s_bad, 0);
+    CHECK(memcmp(s_viewer, fb, FB_BYTES) == 0);
+  }
+  CHECK(s_largest <= FRAME_MAX);
+}
+
+// Random deltas, including dense ones, against the previous frame
+static void test_delta_sequence(void) {
+  static uint8_t prev[FB_BYTES], fb[FB_BYTES];
+  setup();
+  memset(prev, 0, sizeof(prev));
+  display_mirror_send(prev, NULL, 0, PAGES - 1);
+
+  for (int step = 0; step < 500; step++) {
+    fill_pattern(fb, (int)(ref_rand() % 5));
+    int first = ref_rand_range(0, PAGES - 1);
+    int last = ref_rand_range(first, PAGES - 1);
+    // Only the flushed range changes, as display.c guarantees
+    for (int i = 0; i < FB_BYTES; i++) {
+      if (i / OLED_WIDTH < first || i / OLED_WIDTH > last) {
+        fb[i] = prev[i];
+      }
+    }
+    display_mirror_send(fb, prev, first, last);
+    memcpy(prev, fb, sizeof(prev));
+  }
+  CHECK_EQ(s_bad, 0);
+  CHECK(memcmp(s_viewer, prev, FB_BYTES) == 0);
+  CHECK(s_largest <= FRAME_MAX);
+}
+
+// A dropped delta is repaired by the next frame, which is a keyframe
+static void test_drop_resyncs(void) {
+  static uint8_t a[FB_BYTES], b[FB_BYTES], c[FB_BYTES];
+  setup();
+  fill_pattern(a, 3);
+  fill_pattern(b, 3);
+  fill_pattern(c, 3);
+  display_mirror_send(a, NULL, 0, PAGES - 1);
+
+  s_accept = false;
+  display_mirror_send(b, a, 0, PAGES - 1);
+  s_accept = true;
+  display_mirror_send(c, b, 0, PAGES - 1);
+
+  CHECK_EQ(s_keyframes, 2);
+  CHECK(memcmp(s_viewer, c, FB_BYTES) == 0);
+
+  // Back to deltas once the keyframe got through
+  display_mirror_send(a, c, 0, PAGES - 1);
+  CHECK_EQ(s_keyframes, 2);
+  CHECK(memcmp(s_viewer, a, FB_BYTES) == 0);
+}
+
+int main(void) {
+  test_dense_keyframes();
+  test_delta_sequence();
+  test_drop_resyncs();
+  hal_console_host_set_sink(NULL);
+  return TEST_RESULT();
+}
@@ -0,0 +1,144 @@
+/**
+ * @file test_display_primitives.c
+ * @brief Fills, lines and clipped blits against the naive reference
+ *
+ * The mask-based fills and the Bresenham line are compared pixel for pixel
+ * with ref_display.h, including shapes that hang off every edge.
+ */
+
+#include "display.h"
+#include "ref_display.h"
+#include "test_util.h"
+#include "ui_common.h"
+
+#define STEPS 4000
+
+static ref_fb_t s_ref;
+
+static void reset(void) {
+  display_clear();
+  ref_clear(&s_ref);
+}
+
+// Stops after a few reports so one bug does not flood the log
+static void expect_match(int *failures, const char *what) {
+  if (ref_mismatches(&s_ref) != 0 && (*failures)++ < 5) {
+    fprintf(stderr, "framebuffer differs from the reference: %s\n", what);
+    CHECK(0);
+  }
+}
+
+static void test_random_fills(void) {
+  reset();
+
+  int failures = 0;
+  for (int step = 0; step < STEPS; step++) {
+    int x = ref_rand_range(-40, OLED_WIDTH + 8);
+    int y = ref_rand_range(-40, OLED_HEIGHT + 8);
+    int w = ref_rand_range(-4, 80);
+    int h = ref_rand_range(-4, 48);
+    bool on = ref_rand_range(0, 1);
+
+    switch (ref_rand_range(0, 4)) {
+    case 0: {
+      draw_mode_t mode = (draw_mode_t)ref_rand_range(DRAW_SET, DRAW_XOR);
+      display_fill_rect_mode(x, y, w, h, mode);
+      ref_fill_rect(&s_ref, x, y, w, h, mode);
+      expect_match(&failures, "fill_rect_mode");
+      break;
+    }
+    case 1:
+      display_fill_rect(x, y, w, h, on);
+      ref_fill_rect(&s_ref, x, y, w, h, on ? DRAW_SET : DRAW_CLEAR);
+      expect_match(&failures, "fill_rect");
+      break;
+    case 2:
+      display_draw_hline(x, y, w, on);
+      ref_fill_rect(&s_ref, x, y, w, 1, on ? DRAW_SET : DRAW_CLEAR);
+      expect_match(&failures, "hline");
+      break;
+    case 3:
+      display_draw_vline(x, y, h, on);
+      ref_fill_rect(&s_ref, x, y, 1, h, on ? DRAW_SET : DRAW_CLEAR);
+      expect_match(&failures, "vline");
+      break;
+    default:
+      display_draw_rect(x, y, w, h);
+      ref_rect(&s_ref, x, y, w, h);
+      expect_match(&failures, "rect");
+      break;
+    }
+  }
+  CHECK_EQ(failures, 0);
+}
+
+// Every direction and slope from the centre, each on a clean screen
+static void test_line_octants(void) {
+  int failures = 0;
+  for (int dy = -30; dy <= 30; dy++) {
+    for (int dx = -60; dx <= 60; dx++) {
+      reset();
+      display_draw_line(64, 32, 64 + dx, 32 + dy, true);
+      ref_line(&s_ref, 64, 32, 64 + dx, 32 + dy, true);
+      expect_match(&failures, "line octant");
+    }
+  }
+  CHECK_EQ(failures, 0);
+}
+
+// Long lines with endpoints off screen, set and cleared over each other
+static void test_random_lines(void) {
+  reset();
+
+  int failures = 0;
+  for (int step = 0; step < STEPS; step++) {
+    int x0 = ref_rand_range(-60, OLED_WIDTH + 60);
+    int y0 = ref_rand_range(-60, OLED_HEIGHT + 60);
+    int x1 = ref_rand_range(-60, OLED_WIDTH + 60);
+    int y1 = ref_rand_range(-60, OLED_HEIGHT + 60);
+    bool on = ref_rand() % 4 != 0;
+
+    display_draw_line(x0, y0, x1, y1, on);
+    ref_line(&s_ref, x0, y0, x1, y1, on);
+    expect_match(&failures, "random line");
+  }
+  CHECK_EQ(failures, 0);
+}
+
+// A 20x20 bitmap slid across each edge one pixel at a time
+static void test_clipped_blits(void) {
+  uint8_t bitmap[3 * 20];
+  for (size_t i = 0; i < sizeof(bitmap); i++) {
+    bitmap[i] = (uint8_t)ref_rand();
+  }
+
+  int failures = 0;
+  for (int mode = DRAW_SET; mode <= DRAW_XOR; mode++) {
+    for (int off = -21; off <= 1; off++) {
+      const int pos[4][2] = {
+          {off, 20},                   // Left
+          {OLED_WIDTH - 20 - off, 20}, // Right
+          {50, off},                   // Top
+          {50, OLED_HEIGHT - 20 - off} // Bottom
+      };
+      for (int e = 0; e < 4; e++) {
+        reset();
+        display_fill_rect(0, 0, OLED_WIDTH, OLED_HEIGHT / 2, true);
+        ref_fill_rect(&s_ref, 0, 0, OLED_WIDTH, OLED_HEIGHT / 2, DRAW_SET);
+        display_blit(pos[e][0], pos[e][1], bitmap, 20, 20, (draw_mode_t)mode);
+        ref_blit(&s_ref, pos[e][0], pos[e][1], bitmap, 20, 20,
+                 (draw_mode_t)mode);
+        expect_match(&failures, "clipped blit");
+      }
+    }
+  }
+  CHECK_EQ(failures, 0);
+}
+
+int main(void) {
+  test_random_fills();
+  test_line_octants();
+  test_random_lines();
+  test_clipped_blits();
+  return TEST_RESULT();
+}
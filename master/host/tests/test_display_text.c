@@ -0,0 +1,136 @@
+/**
+ * @file test_display_text.c
+ * @brief Column blitter and text drawing against the naive reference
+ *
+ * Random glyphs, strings and column bitmaps at any alignment, partly off
+ * screen, in every draw mode, on top of whatever earlier steps left in the
+ * framebuffer.
+ */
+
+#include "display.h"
+#include "font.h"
+#include "ref_display.h"
+#include "test_util.h"
+#include "ui_common.h"
+
+#define STEPS 4000
+
+static ref_fb_t s_ref;
+
+static draw_mode_t random_mode(void) {
+  return (draw_mode_t)ref_rand_range(DRAW_SET, DRAW_XOR);
+}
+
+static void random_string(char *s, int max) {
+  int n = ref_rand_range(0, max);
+  for (int i = 0; i < n; i++) {
+    s[i] = (char)ref_rand_range(0, 1) ? (char)ref_rand_range(32, 126)
+                                      : (char)ref_rand_range(0, 255);
+  }
+  s[n] = '\0';
+}
+
+static const font_t *random_font(void) {
+  return ref_rand_range(0, 1) ? &font_digits_8x16 : &font_5x7;
+}
+
+static void test_random_text(void) {
+  display_clear();
+  ref_clear(&s_ref);
+
+  int failures = 0;
+  for (int step = 0; step < STEPS; step++) {
+    int x = ref_rand_range(-30, OLED_WIDTH + 4);
+    int y = ref_rand_range(-26, OLED_HEIGHT + 4);
+    draw_mode_t mode = random_mode();
+    char str[24];
+
+    switch (ref_rand_range(0, 5)) {
+    case 0: {
+      char c = (char)ref_rand_range(0, 255);
+      display_draw_char(x, y, c);
+      ref_draw_char(&s_ref, x, y, c);
+      break;
+    }
+    case 1: {
+      char c = (char)ref_rand_range(32, 126);
+      display_draw_char_mode(x, y, c, mode);
+      ref_draw_text(&s_ref, x, y, (char[]){c, 0}, &font_5x7, mode);
+      break;
+    }
+    case 2:
+      random_string(str, 22);
+      display_draw_string(x, y, str);
+      ref_draw_string(&s_ref, x, y, str);
+      break;
+    case 3: {
+      random_string(str, 8);
+      const font_t *font = random_font();
+      int end = display_draw_text(x, y, str, font, mode);
+      CHECK_EQ(end, ref_draw_text(&s_ref, x, y, str, font, mode));
+      break;
+    }
+    case 4: {
+      uint8_t cols[40];
+      int w = ref_rand_range(0, 40), h = ref_rand_range(0, 8);
+      for (int i = 0; i < w; i++) {
+        cols[i] = (uint8_t)ref_rand();
+      }
+      display_blit_columns(x, y, cols, w, h, mode);
+      ref_blit_columns(&s_ref, x, y, cols, w, h, mode);
+      break;
+    }
+    default: {
+      uint8_t bitmap[3 * 24];
+      int w = ref_rand_range(1, 24), h = ref_rand_range(1, 24);
+      for (int i = 0; i < 3 * 24; i++) {
+        bitmap[i] = (uint8_t)ref_rand();
+      }
+      display_blit(x, y, bitmap, w, h, mode);
+      ref_blit(&s_ref, x, y, bitmap, w, h, mode);
+      break;
+    }
+    }
+
+    if (ref_mismatches(&s_ref) != 0 && failures++ < 5) {
+      CHECK(!"framebuffer differs from the reference");
+    }
+  }
+  CHECK_EQ(failures, 0);
+}
+
+static void test_xor_is_reversible(void) {
+  display_clear();
+  ref_clear(&s_ref);
+  display_fill_rect(0, 0, 128, 12, true);
+  for (int y = 0; y < 12; y++) {
+    for (int x = 0; x < 128; x++) {
+      s_ref.px[y][x] = true;
+    }
+  }
+
+  // Highlighted header text twice = untouched bar
+  display_draw_string_mode(3, 3, "SETTINGS", DRAW_XOR);
+  CHECK(ref_mismatches(&s_ref) > 0);
+  display_draw_string_mode(3, 3, "SETTINGS", DRAW_XOR);
+  CHECK_EQ(ref_mismatches(&s_ref), 0);
+}
+
+static void test_text_width(void) {
+  CHECK_EQ(display_text_width("", &font_5x7), 0);
+  CHECK_EQ(display_text_width("A", &font_5x7), 5);
+  CHECK_EQ(display_text_width("ABC", &font_5x7), 3 * 6 - 1);
+
+  // Width matches where drawing ends, minus the trailing spacing
+  const char *s = "-12.5";
+  int end = display_draw_text(0, 0, s, &font_digits_8x16, DRAW_SET);
+  CHECK_EQ(display_text_width(s, &font_digits_8x16),
+           end - font_digits_8x16.spacing);
+}
+
+int main(void) {
+  test_random_text();
+  test_xor_is_reversible();
+  test_text_width();
+  return TEST_RESULT();
+}
@@ -0,0 +1,153 @@
+/**
+ * @file test_drive_shaping.c
+ * @brief Q15 shaping and mixers against a floating-point reference
+ *
+ * The reference evaluates the formulas of drive_shaping.c in double
+ * precision; the integer kernel must match it to the bit on the whole
+ * -255..255 x -255..255 stick grid.
+ */
+
+#include <math.h>
+#include <stdlib.h>
+
+#include "config.h"
+#include "drive_shaping.h"
+#include "test_util.h"
+
+// ============================================================
+// FLOAT REFERENCE
+// ============================================================
+static int16_t ref_axis(int raw) {
+  int mag = abs(raw) > 255 ? 255 : abs(raw);
+  if (mag < DEADZONE) {
+    return 0;
+  }
+  double x = (double)(mag - DEADZONE) / (255 - DEADZONE);
+  double e = SHAPE_EXPO_Q8 / 256.0;
+  double y = floor(32768.0 * ((1.0 - e) * x + e * x * x * x));
+  if (y > Q15_ONE) {
+    y = Q15_ONE;
+  }
+  return (int16_t)(raw < 0 ? -y : y);
+}
+
+static void ref_mix(const double w[4], motor_speeds_t *out) {
+  double peak = 0;
+  for (int i = 0; i < 4; i++) {
+    peak = fmax(peak, fabs(w[i]));
+  }
+  double fs = fmax(peak, 32768.0);
+
+  int16_t d[4];
+  for (int i = 0; i < 4; i++) {
+    double m = floor(fabs(w[i]) * MAX_SPEED / fs + 0.5);
+    d[i] = (int16_t)(w[i] < 0 ? -m : m);
+  }
+  *out = (motor_speeds_t){d[0], d[1], d[2], d[3]};
+}
+
+static void ref_mecanum(double vy, double vx, double om, motor_speeds_t *out) {
+  const double w[4] = {vy + vx + om, vy - vx - om, vy - vx + om,
+                       vy + vx - om};
+  ref_mix(w, out);
+}
+
+static void ref_differential(double t, double s, motor_speeds_t *out) {
+  const double w[4] = {t + s, t - s, 0, 0};
+  ref_mix(w, out);
+  out->bl = out->fl;
+  out->br = out->fr;
+}
+
+static bool same(const motor_speeds_t *a, const motor_speeds_t *b) {
+  return a->fl == b->fl && a->fr == b->fr && a->bl == b->bl && a->br == b->br;
+}
+
+// ============================================================
+// TESTS
+// ============================================================
+static void test_axis(void) {
+  int mismatches = 0;
+  for (int raw = -300; raw <= 300; raw++) {
+    if (shaping_axis((int16_t)raw) != ref_axis(raw)) {
+      mismatches++;
+    }
+  }
+  CHECK_EQ(mismatches, 0);
+
+  CHECK_EQ(shaping_axis(0), 0);
+  CHECK_EQ(shaping_axis(DEADZONE - 1), 0);
+  CHECK_EQ(shaping_axis(255), Q15_ONE);
+  CHECK_EQ(shaping_axis(-255), -Q15_ONE);
+
+  // Monotonic outside the deadzone
+  for (int raw = DEADZONE + 1; raw <= 255; raw++) {
+    CHECK(shaping_axis((int16_t)raw) > shaping_axis((int16_t)(raw - 1)));
+  }
+}
+
+static void test_mecanum_grid(void) {
+  static const int16_t omegas[] = {-255, -128, -40, 0, 30, 200, 255};
+  int mismatches = 0, saturated = 0;
+
+  for (size_t k = 0; k < sizeof(omegas) / sizeof(omegas[0]); k++) {
+    int16_t om = shaping_axis(omegas[k]);
+    for (int t = -255; t <= 255; t++) {
+      int16_t vy = shaping_axis((int16_t)t);
+      for (int s = -255; s <= 255; s++) {
+        int16_t vx = shaping_axis((int16_t)s);
+        motor_speeds_t got, want;
+        shaping_mix_mecanum(vy, vx, om, &got);
+        ref_mecanum(vy, vx, om, &want);
+        if (!same(&got, &want)) {
+          mismatches++;
+        }
+        if (abs(got.fl) == MAX_SPEED || abs(got.fr) == MAX_SPEED) {
+          saturated++;
+        }
+      }
+    }
+  }
+  CHECK_EQ(mismatches, 0);
+  CHECK(saturated > 0); // The grid exercises desaturation
+}
+
+static void test_differential_grid(void) {
+  int mismatches = 0;
+  for (int t = -255; t <= 255; t++) {
+    int16_t th = shaping_axis((int16_t)t);
+    for (int s = -255; s <= 255; s++) {
+      int16_t st = shaping_axis((int16_t)s);
+      motor_speeds_t got, want;
+      shaping_mix_differential(th, st, &got);
+      ref_differential(th, st, &want);
+      if (!same(&got, &want)) {
+        mismatches++;
+      }
+    }
+  }
+  CHECK_EQ(mismatches, 0);
+}
+
+static void test_direction_kept(void) {
+  // Full forward + full strafe: FL/BR at full speed, FR/BL stopped
+  motor_speeds_t m;
+  shaping_mix_mecanum(Q15_ONE, Q15_ONE, 0, &m);
+  CHECK_EQ(m.fl, MAX_SPEED);
+  CHECK_EQ(m.br, MAX_SPEED);
+  CHECK_EQ(m.fr, 0);
+  CHECK_EQ(m.bl, 0);
+
+  // Spin in place: left forward, right backward
+  shaping_mix_differential(0, Q15_ONE, &m);
+  CHECK_EQ(m.fl, MAX_SPEED);
+  CHECK_EQ(m.fr, -MAX_SPEED);
+}
+
+int main(void) {
+  test_axis();
+  test_mecanum_grid();
+  test_differential_grid();
+  test_direction_kept();
+  return TEST_RESULT();
+}
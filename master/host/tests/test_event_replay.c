@@ -0,0 +1,236 @@
+/**
+ * @file test_event_replay.c
+ * @brief Event traces replay deterministically through fsm.c
+ *
+ * A trace is a list of events with their stamps. replay() applies it the
+ * way the control cycle does (dispatch, then the active mode) and records
+ * the context after every event. The same trace must always give the same
+ * record, and a trace recorded from a live run must end in the state that
+ * run reached.
+ */
+
+#include <string.h>
+
+#include "config.h"
+#include "control.h"
+#include "espnow_handler.h"
+#include "event_bus.h"
+#include "fsm.h"
+#include "hal_clock.h"
+#include "hal_host.h"
+#include "motor.h"
+#include "motor_pwm_mock.h"
+#include "protocol.h"
+#include "scheduler.h"
+#include "scheduler_host.h"
+#include "test_util.h"
+#include "types.h"
+
+#define TRACE_MAX 256
+
+// Context fields that inputs can change
+typedef struct {
+  system_state_t state;
+  movement_type_t movement;
+  motor_speeds_t speeds;
+  bool joystick_connected;
+  bool voice_connected;
+  bool estop_latched;
+  int8_t menu_index;
+  uint32_t joystick_frames;
+  uint32_t last_joystick_time;
+  uint32_t last_voice_time;
+  size_t pwm_latches;
+} digest_t;
+
+static digest_t digest(void) {
+  return (digest_t){
+      .state = g_ctx.current_state,
+      .movement = g_ctx.movement,
+      .speeds = g_ctx.motor_speeds,
+      .joystick_connected = g_ctx.joystick_connected,
+      .voice_connected = g_ctx.voice_connected,
+      .estop_latched = g_ctx.estop_latched,
+      .menu_index = g_ctx.menu_index,
+      .joystick_frames = g_ctx.joystick_frames,
+      .last_joystick_time = g_ctx.last_joystick_time,
+      .last_voice_time = g_ctx.last_voice_time,
+      .pwm_latches = motor_pwm_mock_count(),
+  };
+}
+
+static bool digest_equal(const digest_t *a, const digest_t *b) {
+  return a->state == b->state && a->movement == b->movement &&
+         memcmp(&a->speeds, &b->speeds, sizeof(a->speeds)) == 0 &&
+         a->joystick_connected == b->joystick_connected &&
+         a->voice_connected == b->voice_connected &&
+         a->estop_latched == b->estop_latched &&
+         a->menu_index == b->menu_index &&
+         a->joystick_frames == b->joystick_frames &&
+         a->last_joystick_time == b->last_joystick_time &&
+         a->last_voice_time == b->last_voice_time &&
+         a->pwm_latches == b->pwm_latches;
+}
+
+static void fresh_context(void) {
+  memset(&g_ctx, 0, sizeof(g_ctx));
+  motor_pwm_mock_reset();
+  motor_init();
+  motor_set_calibration(255, 255, 255, 255);
+  fsm_init();
+}
+
+// Dispatch, then run the active mode as control_step() does
+static void replay(const system_event_t *trace, size_t n, digest_t *out) {
+  fresh_context();
+  for (size_t i = 0; i < n; i++) {
+    fsm_dispatch(&trace[i]);
+    if (g_ctx.joystick_connected) {
+      fsm_process_joystick();
+    }
+    if (g_ctx.voice_connected) {
+      fsm_process_voice();
+    }
+    out[i] = digest();
+  }
+}
+
+// ============================================================
+// SCRIPTED TRACE
+// ============================================================
+#define MS(t) ((int64_t)(t) * 1000)
+
+static system_event_t button(int64_t t, button_event_t b) {
+  return (system_event_t){.type = EVT_BUTTON, .stamp_us = t, .data.button = b};
+}
+
+static system_event_t joy(int64_t t, int16_t thr, int16_t str, bool btn1) {
+  return (system_event_t){
+      .type = EVT_JOYSTICK_DATA,
+      .stamp_us = t,
+      .data.joystick = {.throttle = thr, .steering = str, .btn1 = btn1},
+  };
+}
+
+static system_event_t voice(int64_t t, uint8_t cmd) {
+  return (system_event_t){.type = EVT_VOICE_CMD,
+                          .stamp_us = t,
+                          .data.voice = {.cmd = cmd, .speed = 150}};
+}
+
+static system_event_t tick(int64_t t) {
+  return (system_event_t){.type = EVT_TIMEOUT, .stamp_us = t};
+}
+
+static const int CHECK_ESTOP = 4, CHECK_TIMEOUT = 7, CHECK_VOICE = 14;
+
+static size_t build_trace(system_event_t *t) {
+  size_t n = 0;
+  t[n++] = button(MS(1000), BTN_EVT_OK_SINGLE); // Menu item 0: mecanum
+  t[n++] = joy(MS(1010), 255, 0, false);
+  t[n++] = tick(MS(1015));
+  t[n++] = joy(MS(1020), 0, 200, false);
+  t[n++] = joy(MS(1030), 0, 200, true); // [4] stick emergency stop
+  t[n++] = joy(MS(1040), 0, 0, false);
+  t[n++] = tick(MS(1040 + CONNECTION_TIMEOUT_MS / 2));
+  t[n++] = tick(MS(1041 + CONNECTION_TIMEOUT_MS)); // [7] link lost
+  t[n++] = button(MS(3000), BTN_EVT_OK_DOUBLE);    // Back to menu
+  t[n++] = button(MS(3100), BTN_EVT_DOWN_PRESSED);
+  t[n++] = button(MS(3200), BTN_EVT_DOWN_PRESSED);
+  t[n++] = button(MS(3300), BTN_EVT_OK_SINGLE); // Menu item 2: voice
+  t[n++] = voice(MS(3400), VOICE_CMD_FORWARD);
+  t[n++] = tick(MS(3405));
+  t[n++] = voice(MS(3500), VOICE_CMD_LEFT); // [14]
+  t[n++] = tick(MS(3501 + CONNECTION_TIMEOUT_MS));
+  return n;
+}
+
+static void test_scripted_trace(void) {
+  system_event_t trace[TRACE_MAX];
+  size_t n = build_trace(trace);
+  digest_t first[TRACE_MAX], second[TRACE_MAX];
+
+  replay(trace, n, first);
+  replay(trace, n, second);
+  for (size_t i = 0; i < n; i++) {
+    CHECK(digest_equal(&first[i], &second[i]));
+  }
+
+  CHECK_EQ(first[1].state, STATE_MODE_MECANUM);
+  CHECK_EQ(first[1].movement, MOVEMENT_FORWARD);
+  CHECK_EQ(first[3].movement, MOVEMENT_STRAFE_RIGHT);
+  CHECK_EQ(first[CHECK_ESTOP].movement, MOVEMENT_EMERGENCY);
+  CHECK_EQ(first[CHECK_ESTOP].speeds.fl, 0);
+  // Button released at neutral: still latched
+  CHECK_EQ(first[CHECK_ESTOP + 1].movement, MOVEMENT_EMERGENCY);
+  CHECK(first[CHECK_ESTOP + 1].estop_latched);
+  CHECK(first[CHECK_TIMEOUT - 1].joystick_connected);
+  CHECK(!first[CHECK_TIMEOUT].joystick_connected);
+  CHECK_EQ(first[CHECK_TIMEOUT].joystick_frames, 4);
+  CHECK_EQ(first[CHECK_VOICE - 1].state, STATE_MODE_VOICE);
+  CHECK_EQ(first[CHECK_VOICE - 1].movement, MOVEMENT_FORWARD);
+  CHECK_EQ(first[CHECK_VOICE].movement, MOVEMENT_ROTATE_LEFT);
+  CHECK(!first[n - 1].voice_connected);
+}
+
+// ============================================================
+// RECORD A LIVE RUN, THEN REPLAY IT
+// ============================================================
+static system_event_t s_recorded[TRACE_MAX];
+static size_t s_recorded_n = 0;
+
+static void record(const system_event_t *evt) {
+  if (s_recorded_n < TRACE_MAX) {
+    s_recorded[s_recorded_n++] = *evt;
+  }
+}
+
+static void send_joystick(int16_t throttle, int16_t steering, uint16_t seq) {
+  static const uint8_t peer[6] = {0x24, 0x6f, 0x28, 0x00, 0x00, 0x02};
+  proto_joystick_msg_t msg = {
+      .joy = {.throttle = throttle, .steering = steering},
+  };
+  size_t len = proto_seal(&msg.hdr, PROTO_MSG_JOYSTICK, seq,
+                          (uint32_t)(hal_time_us() / 1000), sizeof(msg.joy));
+  espnow_handler_receive(peer, -60, (const uint8_t *)&msg, (int)len);
+}
+
+static void test_recorded_run(void) {
+  hal_clock_host_set(MS(5000));
+  fresh_context();
+  event_bus_init();
+  event_bus_set_trace(record);
+  scheduler_init();
+  control_init();
+  scheduler_start();
+
+  event_bus_post_state(STATE_MODE_MECANUM);
+  for (uint16_t i = 0; i < 40; i++) {
+    send_joystick((int16_t)(i * 12 - 240), (int16_t)(i % 7) * 30, i);
+    scheduler_host_run_until(hal_time_us() + 7000);
+  }
+  event_bus_post_button(BTN_EVT_OK_LONG);
+  scheduler_host_run_until(hal_time_us() + 20000);
+  event_bus_set_trace(NULL);
+
+  digest_t live = digest();
+  CHECK(s_recorded_n > 40);
+
+  static digest_t replayed[TRACE_MAX];
+  replay(s_recorded, s_recorded_n, replayed);
+  const digest_t *end = &replayed[s_recorded_n - 1];
+  CHECK_EQ(end->state, live.state);
+  CHECK_EQ(end->movement, live.movement);
+  CHECK_EQ(end->joystick_frames, live.joystick_frames);
+  CHECK_EQ(end->last_joystick_time, live.last_joystick_time);
+  CHECK_EQ(end->estop_latched, live.estop_latched);
+  CHECK(memcmp(&end->speeds, &live.speeds, sizeof(live.speeds)) == 0);
+  CHECK(live.estop_latched);
+  CHECK_EQ(live.movement, MOVEMENT_EMERGENCY); // Held despite the stick
+}
+
+int main(void) {
+  test_scripted_trace();
+  test_recorded_run();
+  return TEST_RESULT();
+}
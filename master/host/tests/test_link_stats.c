@@ -0,0 +1,126 @@
+/**
+ * @file test_link_stats.c
+ * @brief Per-peer link statistics: loss, reordering, restarts, weak link
+ *
+ * Each test uses its own sender address, since the peer table lives for
+ * the whole process.
+ */
+
+#include "espnow_handler.h"
+#include "event_bus.h"
+#include "link_stats.h"
+#include "protocol.h"
+#include "test_util.h"
+#include "ui_common.h"
+
+#define PERIOD_MS 20
+
+static void mac_of(uint8_t id, uint8_t mac[6]) {
+  const uint8_t base[6] = {0x24, 0x6f, 0x28, 0x00, 0x01, id};
+  for (int i = 0; i < 6; i++) {
+    mac[i] = base[i];
+  }
+}
+
+static link_peer_stats_t stats_of(const uint8_t mac[6]) {
+  link_peer_stats_t st = {0};
+  CHECK(link_stats_find(mac, &st));
+  return st;
+}
+
+// A gap, then the missing message one millisecond behind the next one
+static void test_loss_and_reorder(void) {
+  uint8_t mac[6];
+  mac_of(1, mac);
+  int64_t now = 1000000;
+
+  CHECK(link_stats_record(mac, 0, 300, now, -50));
+  CHECK(link_stats_record(mac, 1, 320, now + 20000, -50));
+  CHECK(link_stats_record(mac, 3, 360, now + 60000, -50));
+  CHECK_EQ(stats_of(mac).lost, 1);
+
+  CHECK(link_stats_record(mac, 2, 340, now + 61000, -50));
+  CHECK(!link_stats_record(mac, 2, 340, now + 62000, -50));
+
+  link_peer_stats_t st = stats_of(mac);
+  CHECK_EQ(st.lost, 0);
+  CHECK_EQ(st.reordered, 1);
+  CHECK_EQ(st.duplicates, 1);
+  CHECK_EQ(st.resyncs, 0);
+  CHECK_EQ(st.packets, 4);
+}
+
+// The remote reboots at seq 10 and counts from 0 again; its clock restarts
+// near the same boot time, so the new sequence numbers fall inside the
+// reorder window
+static void test_quick_reboot(void) {
+  uint8_t mac[6];
+  mac_of(2, mac);
+  int64_t now = 2000000;
+  uint16_t seq = 0;
+
+  for (; seq <= 10; seq++) {
+    CHECK(link_stats_record(mac, seq, 300 + seq * PERIOD_MS, now, -50));
+    now += PERIOD_MS * 1000;
+  }
+  now += 400000; // Reset and radio bring-up
+
+  int accepted = 0;
+  for (seq = 0; seq < 5; seq++) {
+    accepted += link_stats_record(mac, seq, 300 + seq * PERIOD_MS, now, -50);
+    now += PERIOD_MS * 1000;
+  }
+
+  link_peer_stats_t st = stats_of(mac);
+  CHECK_EQ(accepted, 5);
+  CHECK_EQ(st.resyncs, 1);
+  CHECK_EQ(st.duplicates, 0);
+  CHECK_EQ(st.reordered, 0);
+  CHECK_EQ(st.lost, 0);
+  CHECK_EQ(st.seq, 4);
+  CHECK_EQ(st.packets, 16);
+}
+
+static void send_joystick(const uint8_t mac[6], uint16_t seq, int8_t rssi) {
+  proto_joystick_msg_t msg = {.joy = {.throttle = 0}};
+  size_t len = proto_seal(&msg.hdr, PROTO_MSG_JOYSTICK, seq,
+                          (uint32_t)seq * PERIOD_MS, sizeof(msg.joy));
+  espnow_handler_receive(mac, rssi, (const uint8_t *)&msg, (int)len);
+}
+
+static void send_voice(const uint8_t mac[6], uint16_t seq, int8_t rssi) {
+  proto_voice_msg_t msg = {.voice = {.cmd = 0, .speed = 100}};
+  size_t len = proto_seal(&msg.hdr, PROTO_MSG_VOICE, seq,
+                          (uint32_t)seq * PERIOD_MS, sizeof(msg.voice));
+  espnow_handler_receive(mac, rssi, (const uint8_t *)&msg, (int)len);
+}
+
+// The status bar follows the controller, not the latest sender
+static void test_weak_follows_controller(void) {
+  uint8_t joy[6], voice[6];
+  mac_of(3, joy);
+  mac_of(4, voice);
+  event_bus_init();
+
+  send_joystick(joy, 0, -50);
+  for (uint16_t seq = 0; seq < 20; seq++) {
+    send_voice(voice, seq, -95);
+    event_bus_init(); // Drain
+  }
+  CHECK(link_stats_weak(voice));
+  CHECK(!link_stats_weak(joy));
+  CHECK(!ui_joystick_link_weak());
+
+  for (uint16_t seq = 1; seq < 40; seq++) {
+    send_joystick(joy, seq, -95);
+    event_bus_init();
+  }
+  CHECK(ui_joystick_link_weak());
+}
+
+int main(void) {
+  test_loss_and_reorder();
+  test_quick_reboot();
+  test_weak_follows_controller();
+  return TEST_RESULT();
+}
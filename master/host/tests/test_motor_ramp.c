@@ -0,0 +1,187 @@
+/**
+ * @file test_motor_ramp.c
+ * @brief Wheel ramp profiles against their analytic curves
+ *
+ * The ramp is stepped at the control period and every output is compared
+ * with the closed-form profile at the same instant, within the one duty
+ * step of output rounding. Completion times allow a tick or two of the
+ * S-curve's final creep onto the target.
+ */
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "motor_ramp.h"
+#include "test_util.h"
+
+#define DT_US 5000
+#define DT_S (DT_US / 1e6)
+
+// Limits for all four wheels; the ramp keeps its current position
+static void configure(uint16_t accel, uint16_t decel, uint16_t jerk) {
+  settings_data_t s;
+  memset(&s, 0, sizeof(s));
+  for (int i = 0; i < 4; i++) {
+    s.ramp_accel[i] = accel;
+    s.ramp_decel[i] = decel;
+  }
+  s.ramp_jerk = jerk;
+  motor_ramp_configure(&s);
+}
+
+static motor_speeds_t all(int16_t v) { return (motor_speeds_t){v, v, v, v}; }
+
+// Put every wheel at v without ramping
+static void jump_to(int16_t v) {
+  motor_ramp_reset();
+  configure(0, 0, 0);
+  motor_speeds_t want = all(v), out;
+  motor_ramp_step(&want, &out, DT_US);
+}
+
+// Step towards target, comparing with curve(t); returns the steps taken
+// to reach the target (-1 if never) and the largest deviation
+static int run_profile(int16_t target, double (*curve)(double t),
+                       int *max_err_out) {
+  motor_speeds_t want = all(target), out;
+  int max_err = 0;
+  int n;
+  for (n = 1; n < 2000; n++) {
+    motor_ramp_step(&want, &out, DT_US);
+    int err = abs(out.fl - (int)lround(curve(n * DT_S)));
+    if (err > max_err) {
+      max_err = err;
+    }
+    if (out.fl == target) {
+      break;
+    }
+  }
+  *max_err_out = max_err;
+  return (n < 2000) ? n : -1;
+}
+
+// ============================================================
+// TRAPEZOID (no jerk limit)
+// ============================================================
+static double accel_510(double t) { return fmin(510.0 * t, 255.0); }
+
+static double decel_1020(double t) { return fmax(255.0 - 1020.0 * t, 0.0); }
+
+// +255 -> -255: decel to zero at 1020/s, then accelerate at 510/s
+static double reverse(double t) {
+  if (t <= 0.25) {
+    return 255.0 - 1020.0 * t;
+  }
+  return fmax(-510.0 * (t - 0.25), -255.0);
+}
+
+static void test_linear_accel(void) {
+  jump_to(0);
+  configure(510, 1020, 0);
+  int err;
+  CHECK_EQ(run_profile(255, accel_510, &err), 100); // 255 / 510 s = 0.5 s
+  CHECK(err <= 1);
+}
+
+static void test_linear_decel(void) {
+  jump_to(255);
+  configure(510, 1020, 0);
+  int err;
+  CHECK_EQ(run_profile(0, decel_1020, &err), 50); // 255 / 1020 s = 0.25 s
+  CHECK(err <= 1);
+}
+
+static void test_reversal(void) {
+  jump_to(255);
+  configure(510, 1020, 0);
+  int err;
+  CHECK_EQ(run_profile(-255, reverse, &err), 150); // 0.25 s down, 0.5 s up
+  CHECK(err <= 1);
+}
+
+static void test_per_wheel_limits(void) {
+  settings_data_t s;
+  memset(&s, 0, sizeof(s));
+  const uint16_t accel[4] = {255, 510, 1020, 0};
+  memcpy(s.ramp_accel, accel, sizeof(accel));
+  motor_ramp_configure(&s);
+  motor_ramp_reset();
+
+  motor_speeds_t want = all(255), out;
+  for (int n = 1; n <= 20; n++) { // 0.1 s
+    motor_ramp_step(&want, &out, DT_US);
+  }
+  CHECK(abs(out.fl - 26) <= 1);  // 255/s
+  CHECK(abs(out.fr - 51) <= 1);  // 510/s
+  CHECK(abs(out.bl - 102) <= 1); // 1020/s
+  CHECK_EQ(out.br, 255);         // Unlimited
+}
+
+// ============================================================
+// S-CURVE (jerk limited)
+// ============================================================
+// Jerk only (accel not reached): 0 -> X in T = 2 sqrt(X / J), position
+// J t^2 / 2 on the way up, mirrored on the way down.
+#define JERK 4080.0
+#define TARGET 255.0
+
+static double s_curve(double t) {
+  double half = sqrt(TARGET / JERK);
+  if (t <= half) {
+    return JERK * t * t / 2;
+  }
+  if (t >= 2 * half) {
+    return TARGET;
+  }
+  double r = 2 * half - t;
+  return TARGET - JERK * r * r / 2;
+}
+
+static void test_s_curve(void) {
+  jump_to(0);
+  configure(2000, 2000, (uint16_t)JERK);
+  int err;
+  int steps = run_profile((int16_t)TARGET, s_curve, &err);
+  CHECK(abs(steps - 100) <= 2); // 2 sqrt(255 / 4080) = 0.5 s
+  CHECK(err <= 1);
+}
+
+// Jerk and accel limit: slope rises at J to A, cruises, then tapers;
+// the move takes X / A + A / J.
+#define ACCEL 510.0
+
+static double s_curve_capped(double t) {
+  double t1 = ACCEL / JERK;
+  double total = TARGET / ACCEL + t1;
+  if (t <= t1) {
+    return JERK * t * t / 2;
+  }
+  if (t <= total - t1) {
+    return JERK * t1 * t1 / 2 + ACCEL * (t - t1);
+  }
+  if (t >= total) {
+    return TARGET;
+  }
+  double r = total - t;
+  return TARGET - JERK * r * r / 2;
+}
+
+static void test_s_curve_with_accel_cap(void) {
+  jump_to(0);
+  configure((uint16_t)ACCEL, (uint16_t)ACCEL, (uint16_t)JERK);
+  int err;
+  int steps = run_profile((int16_t)TARGET, s_curve_capped, &err);
+  CHECK(abs(steps - 125) <= 2); // 255 / 510 + 510 / 4080 = 0.625 s
+  CHECK(err <= 1);
+}
+
+int main(void) {
+  test_linear_accel();
+  test_linear_decel();
+  test_reversal();
+  test_per_wheel_limits();
+  test_s_curve();
+  test_s_curve_with_accel_cap();
+  return TEST_RESULT();
+}
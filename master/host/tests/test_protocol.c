@@ -0,0 +1,200 @@
+/**
+ * @file test_protocol.c
+ * @brief Wire protocol: known answers, corruption and fuzzing
+ *
+ * Valid messages must parse; every truncation and every one- or two-bit
+ * error must not. Random and mutated packets, some resealed so they pass
+ * the CRC with nonsense lengths and types, go through proto_parse() and
+ * the receive path in exactly sized heap buffers (built with
+ * AddressSanitizer where the compiler has it).
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "espnow_handler.h"
+#include "event_bus.h"
+#include "input_snapshot.h"
+#include "protocol.h"
+#include "test_util.h"
+
+#define FUZZ_PACKETS 200000
+#define ESPNOW_MAX_LEN 250
+
+static const uint8_t s_peer[6] = {0x24, 0x6f, 0x28, 0x00, 0x00, 0x02};
+
+// Deterministic pseudo-random numbers (xorshift32)
+static uint32_t s_rng = 0x2545F491u;
+
+static uint32_t rand32(void) {
+  s_rng ^= s_rng << 13;
+  s_rng ^= s_rng >> 17;
+  s_rng ^= s_rng << 5;
+  return s_rng;
+}
+
+// Uniform in [lo, hi]
+static int rand_range(int lo, int hi) {
+  return lo + (int)(rand32() % (uint32_t)(hi - lo + 1));
+}
+
+// A sealed message of the given type with random payload bytes
+static size_t make_message(uint8_t *buf, uint8_t type, uint16_t length) {
+  for (uint16_t i = 0; i < length; i++) {
+    buf[sizeof(proto_header_t) + i] = (uint8_t)rand32();
+  }
+  return proto_seal((proto_header_t *)buf, type, (uint16_t)rand32(),
+                    rand32(), length);
+}
+
+static void test_crc_known_answer(void) {
+  // CRC-16/CCITT-FALSE check value
+  CHECK_EQ(proto_crc16(0xFFFF, (const uint8_t *)"123456789", 9), 0x29B1);
+  CHECK_EQ(proto_crc16(0xFFFF, NULL, 0), 0xFFFF);
+}
+
+static void test_round_trip(void) {
+  static const uint16_t lengths[PROTO_MSG_COUNT] = {
+      [PROTO_MSG_JOYSTICK] = sizeof(proto_joystick_t),
+      [PROTO_MSG_VOICE] = sizeof(proto_voice_t),
+      [PROTO_MSG_TELEMETRY] = sizeof(proto_telemetry_t),
+      [PROTO_MSG_JOYSTICK_COMPACT] = sizeof(proto_joystick_compact_t),
+  };
+  uint8_t buf[64];
+
+  for (int type = PROTO_MSG_JOYSTICK; type < PROTO_MSG_COUNT; type++) {
+    size_t len = make_message(buf, (uint8_t)type, lengths[type]);
+    const proto_header_t *hdr = NULL;
+    CHECK_EQ(len, sizeof(proto_header_t) + lengths[type]);
+    CHECK_EQ(proto_parse(buf, len, &hdr), PROTO_OK);
+    CHECK(hdr == (const proto_header_t *)buf);
+    CHECK(proto_payload(hdr) == buf + sizeof(proto_header_t));
+  }
+}
+
+static void test_truncation(void) {
+  uint8_t buf[64];
+  size_t len = make_message(buf, PROTO_MSG_JOYSTICK, sizeof(proto_joystick_t));
+  const proto_header_t *hdr;
+
+  for (size_t n = 0; n < len; n++) {
+    uint8_t *copy = malloc(n ? n : 1);
+    memcpy(copy, buf, n);
+    CHECK_EQ(proto_parse(copy, n, &hdr), PROTO_ERR_SHORT);
+    free(copy);
+  }
+}
+
+// CRC-16 catches every 1- and 2-bit error in a message this short
+static void test_bit_errors(void) {
+  uint8_t buf[64];
+  size_t len = make_message(buf, PROTO_MSG_JOYSTICK, sizeof(proto_joystick_t));
+  const proto_header_t *hdr;
+  int accepted = 0;
+
+  for (size_t a = 0; a < len * 8; a++) {
+    buf[a / 8] ^= (uint8_t)(1 << (a % 8));
+    accepted += proto_parse(buf, len, &hdr) == PROTO_OK;
+    for (size_t b = a + 1; b < len * 8; b++) {
+      buf[b / 8] ^= (uint8_t)(1 << (b % 8));
+      accepted += proto_parse(buf, len, &hdr) == PROTO_OK;
+      buf[b / 8] ^= (uint8_t)(1 << (b % 8));
+    }
+    buf[a / 8] ^= (uint8_t)(1 << (a % 8));
+  }
+  CHECK_EQ(accepted, 0);
+  CHECK_EQ(proto_parse(buf, len, &hdr), PROTO_OK);
+}
+
+// One fuzz packet: garbage, a mutated valid message, or a mutated one
+// resealed so the CRC passes
+static size_t fuzz_packet(uint8_t *buf) {
+  int kind = rand_range(0, 3);
+  if (kind == 0) {
+    size_t len = (size_t)rand_range(0, ESPNOW_MAX_LEN);
+    for (size_t i = 0; i < len; i++) {
+      buf[i] = (uint8_t)rand32();
+    }
+    return len;
+  }
+
+  uint8_t type = (uint8_t)rand_range(0, PROTO_MSG_COUNT);
+  uint16_t length = (uint16_t)rand_range(0, 24);
+  size_t len = make_message(buf, type, length);
+  int flips = rand_range(1, 4);
+  for (int i = 0; i < flips; i++) {
+    buf[rand32() % len] ^= (uint8_t)rand_range(1, 255);
+  }
+  if (kind == 3) {
+    proto_header_t *hdr = (proto_header_t *)buf;
+    hdr->magic = PROTO_MAGIC;
+    hdr->version = PROTO_VERSION;
+    hdr->crc = (hdr->length <= len - sizeof(*hdr)) ? proto_message_crc(hdr)
+                                                   : hdr->crc;
+  }
+  // Cut short now and then
+  return rand_range(0, 7) ? len : (size_t)rand_range(0, (int)len);
+}
+
+static void test_fuzz_receive(void) {
+  event_bus_init();
+
+  // The receive path logs every rejected packet
+  fflush(stderr);
+  int saved = dup(2);
+  if (!freopen("/dev/null", "w", stderr)) {
+    CHECK(0);
+  }
+
+  uint8_t buf[ESPNOW_MAX_LEN];
+  int parsed = 0, overlong = 0, bad_axes = 0;
+  uint32_t frames = 0;
+  for (int i = 0; i < FUZZ_PACKETS; i++) {
+    size_t len = fuzz_packet(buf);
+    uint8_t *pkt = malloc(len ? len : 1);
+    memcpy(pkt, buf, len);
+
+    const proto_header_t *hdr;
+    uint8_t type = 0;
+    if (proto_parse(pkt, len, &hdr) == PROTO_OK) {
+      parsed++;
+      type = hdr->type;
+      overlong += sizeof(*hdr) + hdr->length > len;
+    }
+    espnow_handler_receive(s_peer, -40, pkt, (int)len);
+    free(pkt);
+
+    // Whatever got through is in range where the protocol promises it
+    joystick_frame_t f;
+    if (input_snapshot_read_joystick(&f) && f.count != frames) {
+      frames = f.count;
+      if (type == PROTO_MSG_JOYSTICK_COMPACT &&
+          (abs(f.data.throttle) > PROTO_AXIS_BIAS ||
+           abs(f.data.steering) > PROTO_AXIS_BIAS ||
+           abs(f.data.aux_x) > PROTO_AXIS_BIAS ||
+           abs(f.data.aux_y) > PROTO_AXIS_BIAS || f.data.mode > 3)) {
+        bad_axes++;
+      }
+    }
+    event_bus_init(); // Drain, so posting never fails for lack of room
+  }
+
+  fflush(stderr);
+  dup2(saved, 2);
+  close(saved);
+
+  CHECK(parsed > FUZZ_PACKETS / 10); // The resealed share got through
+  CHECK_EQ(overlong, 0);
+  CHECK(frames > 0);
+  CHECK_EQ(bad_axes, 0);
+}
+
+int main(void) {
+  test_crc_known_answer();
+  test_round_trip();
+  test_truncation();
+  test_bit_errors();
+  test_fuzz_receive();
+  return TEST_RESULT();
+}
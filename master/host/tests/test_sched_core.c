@@ -0,0 +1,213 @@
+/**
+ * @file test_sched_core.c
+ * @brief Rate-group core under a simulated clock
+ *
+ * The clock only moves when the test (or a group body standing in for
+ * execution time) advances it, so release times, jitter and misses are
+ * exact.
+ */
+
+#include "sched_core.h"
+#include "test_util.h"
+
+static uint64_t s_now = 0;
+static sched_core_t s_core;
+
+static uint64_t sim_clock(void) { return s_now; }
+
+// Group bodies: record the order they ran in and burn simulated time
+static char s_order[64];
+static int s_order_len = 0;
+static uint32_t s_cost_us = 0;
+
+static void note(char c) {
+  if (s_order_len < (int)sizeof(s_order) - 1) {
+    s_order[s_order_len++] = c;
+    s_order[s_order_len] = '\0';
+  }
+  s_now += s_cost_us;
+}
+
+static void group_a(void) { note('a'); }
+static void group_b(void) { note('b'); }
+static void group_c(void) { note('c'); }
+
+static void reset(void) {
+  s_now = 1000000;
+  s_order_len = 0;
+  s_order[0] = '\0';
+  s_cost_us = 0;
+  sched_core_init(&s_core, sim_clock);
+}
+
+// Step the clock to each reported release, like the executive's timer
+static void run_until(uint64_t end) {
+  uint64_t next = sched_core_run_due(&s_core, s_now);
+  while (next <= end) {
+    if (next > s_now) {
+      s_now = next;
+    }
+    next = sched_core_run_due(&s_core, s_now);
+  }
+  s_now = end;
+}
+
+static void test_rates(void) {
+  reset();
+  CHECK_EQ(sched_core_add_group(&s_core, "fast", 5000, group_a), 0);
+  CHECK_EQ(sched_core_add_group(&s_core, "mid", 10000, group_b), 1);
+  CHECK_EQ(sched_core_add_group(&s_core, "slow", 50000, group_c), 2);
+  CHECK_EQ(sched_core_base_period(&s_core), 5000);
+
+  sched_core_start(&s_core, s_now);
+  run_until(s_now + 1000000 - 1);
+
+  sched_stats_t st;
+  CHECK(sched_core_get_stats(&s_core, 0, &st));
+  CHECK_EQ(st.runs, 200);
+  CHECK_EQ(st.max_jitter_us, 0);
+  CHECK_EQ(st.deadline_misses, 0);
+  CHECK(sched_core_get_stats(&s_core, 1, &st));
+  CHECK_EQ(st.runs, 100);
+  CHECK(sched_core_get_stats(&s_core, 2, &st));
+  CHECK_EQ(st.runs, 20);
+  CHECK(!sched_core_get_stats(&s_core, 3, &st));
+}
+
+static void test_priority_order(void) {
+  reset();
+  sched_core_add_group(&s_core, "fast", 5000, group_a);
+  sched_core_add_group(&s_core, "slow", 10000, group_b);
+  sched_core_start(&s_core, s_now);
+  run_until(s_now + 10000);
+
+  // Joint releases run fastest first
+  CHECK(s_order[0] == 'a' && s_order[1] == 'b' && s_order[2] == 'a' &&
+        s_order[3] == 'a' && s_order[4] == 'b');
+}
+
+static void test_execution_time(void) {
+  reset();
+  sched_core_add_group(&s_core, "fast", 5000, group_a);
+  sched_core_add_group(&s_core, "slow", 10000, group_b);
+  sched_core_start(&s_core, s_now);
+
+  // 'a' delays 'b' by its execution time: that is b's jitter
+  s_cost_us = 1500;
+  sched_core_run_due(&s_core, s_now);
+  sched_stats_t st;
+  sched_core_get_stats(&s_core, 0, &st);
+  CHECK_EQ(st.last_exec_us, 1500);
+  CHECK_EQ(st.last_jitter_us, 0);
+  sched_core_get_stats(&s_core, 1, &st);
+  CHECK_EQ(st.last_jitter_us, 1500);
+  CHECK_EQ(st.deadline_misses, 0);
+}
+
+static void test_overrun_no_drift(void) {
+  reset();
+  sched_core_add_group(&s_core, "fast", 5000, group_a);
+  uint64_t epoch = s_now;
+  sched_core_start(&s_core, epoch);
+
+  // One 7 ms run overruns its 5 ms period
+  s_cost_us = 7000;
+  uint64_t next = sched_core_run_due(&s_core, s_now);
+  sched_stats_t st;
+  sched_core_get_stats(&s_core, 0, &st);
+  CHECK_EQ(st.deadline_misses, 1);
+  CHECK_EQ(next, epoch + 5000); // Anchored to the schedule
+
+  // The late release runs at once with 2 ms jitter, then the grid resumes
+  s_cost_us = 0;
+  next = sched_core_run_due(&s_core, s_now);
+  sched_core_get_stats(&s_core, 0, &st);
+  CHECK_EQ(st.last_jitter_us, 2000);
+  CHECK_EQ(next, epoch + 10000);
+}
+
+static void test_skipped_releases(void) {
+  reset();
+  sched_core_add_group(&s_core, "fast", 5000, group_a);
+  uint64_t epoch = s_now;
+  sched_core_start(&s_core, epoch);
+  sched_core_run_due(&s_core, s_now);
+
+  // Executive stalled for 3.5 periods: three releases are lost, not queued
+  s_now = epoch + 5000 + 17500;
+  uint64_t next = sched_core_run_due(&s_core, s_now);
+  sched_stats_t st;
+  sched_core_get_stats(&s_core, 0, &st);
+  CHECK_EQ(st.runs, 2);
+  CHECK_EQ(st.deadline_misses, 3);
+  CHECK_EQ(st.last_jitter_us, 2500);
+  CHECK_EQ(next, epoch + 25000);
+}
+
+static void test_trigger(void) {
+  reset();
+  int idx = sched_core_add_group(&s_core, "ctl", 20000, group_a);
+  uint64_t epoch = s_now;
+  sched_core_start(&s_core, epoch);
+  sched_core_run_due(&s_core, s_now);
+
+  // Ignored until enabled
+  sched_core_trigger(&s_core, idx);
+  CHECK_EQ(sched_core_next_trigger(&s_core), UINT64_MAX);
+
+  sched_core_set_trigger(&s_core, idx, 1000);
+  s_now = epoch + 3000;
+  sched_core_trigger(&s_core, idx);
+  sched_core_run_due(&s_core, s_now);
+  sched_stats_t st;
+  sched_core_get_stats(&s_core, idx, &st);
+  CHECK_EQ(st.triggered_runs, 1);
+  CHECK_EQ(st.runs, 1);
+
+  // A second trigger inside the minimum gap is deferred, not dropped
+  s_now = epoch + 3400;
+  sched_core_trigger(&s_core, idx);
+  uint64_t next = sched_core_run_due(&s_core, s_now);
+  CHECK_EQ(next, epoch + 4000);
+  CHECK_EQ(sched_core_next_trigger(&s_core), epoch + 4000);
+  s_now = next;
+  sched_core_run_due(&s_core, s_now);
+  sched_core_get_stats(&s_core, idx, &st);
+  CHECK_EQ(st.triggered_runs, 2);
+
+  // Periodic releases are unchanged by triggered runs
+  run_until(epoch + 20000);
+  sched_core_get_stats(&s_core, idx, &st);
+  CHECK_EQ(st.runs, 2);
+  CHECK_EQ(st.last_jitter_us, 0);
+}
+
+static void test_limits(void) {
+  reset();
+  CHECK_EQ(sched_core_add_group(&s_core, "zero", 0, group_a), -1);
+  CHECK_EQ(sched_core_add_group(&s_core, "null", 1000, NULL), -1);
+  for (int i = 0; i < SCHED_MAX_GROUPS; i++) {
+    CHECK_EQ(sched_core_add_group(&s_core, "g", 1000, group_a), i);
+  }
+  CHECK_EQ(sched_core_add_group(&s_core, "full", 1000, group_a), -1);
+  CHECK_EQ(sched_core_base_period(&s_core), 1000);
+
+  sched_core_start(&s_core, s_now);
+  run_until(s_now + 10000);
+  sched_core_reset_stats(&s_core);
+  sched_stats_t st;
+  sched_core_get_stats(&s_core, 0, &st);
+  CHECK_EQ(st.runs, 0);
+  CHECK_EQ(st.max_exec_us, 0);
+}
+
+int main(void) {
+  test_rates();
+  test_priority_order();
+  test_execution_time();
+  test_overrun_no_drift();
+  test_skipped_releases();
+  test_trigger();
+  test_limits();
+  return TEST_RESULT();
+}
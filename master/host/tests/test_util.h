@@ -0,0 +1,42 @@
+/**
+ * @file test_util.h
+ * @brief Minimal assertion helpers for the host tests
+ *
+ * A failed CHECK prints its location and marks the test failed; the test
+ * keeps running so one run reports every failure. main() returns
+ * TEST_RESULT() for ctest.
+ */
+
+#ifndef TEST_UTIL_H
+#define TEST_UTIL_H
+
+#include <stdio.h>
+
+static int s_test_failures = 0;
+
+#define CHECK(cond)                                                            \
+  do {                                                                         \
+    if (!(cond)) {                                                             \
+      fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__,        \
+              #cond);                                                          \
+      s_test_failures++;                                                       \
+    }                                                                          \
+  } while (0)
+
+#define CHECK_EQ(a, b)                                                         \
+  do {                                                                         \
+    long long va_ = (long long)(a), vb_ = (long long)(b);                      \
+    if (va_ != vb_) {                                                          \
+      fprintf(stderr, "%s:%d: %s == %s failed (%lld != %lld)\n", __FILE__,     \
+              __LINE__, #a, #b, va_, vb_);                                     \
+      s_test_failures++;                                                       \
+    }                                                                          \
+  } while (0)
+
+#define TEST_RESULT()                                                          \
+  (s_test_failures ? (fprintf(stderr, "%d check(s) failed\n",                  \
+                              s_test_failures),                                \
+                      1)                                                       \
+                   : 0)
+
+#endif // TEST_UTIL_H
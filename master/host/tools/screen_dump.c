@@ -0,0 +1,348 @@
+/**
+ * @file screen_dump.c
+ * @brief Render every screen from scripted states, dump PBMs and costs
+ *
+ *   screen_dump <out_dir>              # write <screen>.pbm and costs.txt
+ *   screen_dump --check <golden_dir>   # compare with committed set
+ *
+ * Prints one cost line per screen. Screens render in a fixed order from a
+ * fixed state, so the images and the work counts are reproducible. The
+ * check mode (run by ctest against master/host/golden) fails on any pixel
+ * that differs from the reference images and on any count above the one
+ * in costs.txt (us is wall-clock and not compared). After an intended UI
+ * or cost change, regenerate the set with screen_dump master/host/golden
+ * and review it in the diff. Bytes are those of the flush after the
+ * previous screen (the panel keeps its content).
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "display.h"
+#include "espnow_handler.h"
+#include "event_bus.h"
+#include "hal_host.h"
+#include "mode_mecanum.h"
+#include "mode_rc.h"
+#include "protocol.h"
+#include "types.h"
+
+static const uint8_t s_remote_mac[6] = {0x24, 0x6f, 0x28, 0x00, 0x00, 0x01};
+
+typedef struct {
+  const char *name;
+  void (*setup)(void);
+  bool refresh; // Changed widgets only, over the previous screen
+} screen_t;
+
+#define COST_COUNT 4
+
+// Deterministic work counts of one screen, in costs.txt column order
+typedef struct {
+  char name[32];
+  unsigned v[COST_COUNT];
+} cost_t;
+
+static const char *const s_cost_names[COST_COUNT] = {"pixels", "blit", "fill",
+                                                     "bytes"};
+
+// ============================================================
+// SCRIPTED STATES
+// ============================================================
+static void base_state(void) {
+  memset(&g_ctx, 0, sizeof(g_ctx));
+  g_ctx.settings.brightness = 200;
+  g_ctx.settings.volume = 128;
+  g_ctx.settings.motor_cal_fl = 255;
+  g_ctx.settings.motor_cal_fr = 250;
+  g_ctx.settings.motor_cal_bl = 245;
+  g_ctx.settings.motor_cal_br = 240;
+}
+
+static void drive_state(system_state_t state) {
+  base_state();
+  g_ctx.current_state = state;
+  g_ctx.joystick_connected = true;
+  g_ctx.voice_connected = true;
+  g_ctx.joystick.throttle = 180;
+  g_ctx.joystick.steering = -64;
+  g_ctx.movement = MOVEMENT_FORWARD;
+  g_ctx.motor_speeds = (motor_speeds_t){200, -120, 255, -30};
+  g_ctx.control_loop_us = 143;
+}
+
+static void menu_top(void) { base_state(); }
+
+static void menu_last(void) {
+  base_state();
+  g_ctx.menu_index = 3;
+}
+
+static void mecanum_waiting(void) {
+  base_state();
+  g_ctx.current_state = STATE_MODE_MECANUM;
+}
+
+static void mecanum_driving(void) { drive_state(STATE_MODE_MECANUM); }
+
+// The stick moves on the live screen: only the readouts change
+static void mecanum_stick(void) {
+  g_ctx.joystick.throttle = 90;
+  g_ctx.joystick.steering = 12;
+}
+
+static void mecanum_telemetry(void) {
+  drive_state(STATE_MODE_MECANUM);
+  mode_mecanum_handle_button(BTN_EVT_UP_PRESSED);
+}
+
+// Telemetry still shown; a stalled control loop must not widen its cell
+static void mecanum_slow_loop(void) {
+  drive_state(STATE_MODE_MECANUM);
+  g_ctx.control_loop_us = 123456;
+}
+
+static void mecanum_back(void) {
+  drive_state(STATE_MODE_MECANUM);
+  mode_mecanum_handle_button(BTN_EVT_DOWN_PRESSED);
+}
+
+static void rc_driving(void) {
+  drive_state(STATE_MODE_RC);
+  g_ctx.movement = MOVEMENT_TURN_LEFT;
+}
+
+static void voice_listening(void) {
+  base_state();
+  g_ctx.current_state = STATE_MODE_VOICE;
+  g_ctx.voice_connected = true;
+  g_ctx.voice_cmd = 0x01;
+  g_ctx.voice_speed = 150;
+}
+
+static void settings_main(void) {
+  base_state();
+  g_ctx.current_state = STATE_MODE_SETTINGS;
+  g_ctx.settings_menu = SETTINGS_MAIN;
+  g_ctx.settings_index = 1;
+}
+
+static void settings_brightness(void) {
+  settings_main();
+  g_ctx.settings_menu = SETTINGS_BRIGHTNESS;
+}
+
+static void settings_motor_cal(void) {
+  settings_main();
+  g_ctx.settings_menu = SETTINGS_MOTOR_CAL;
+}
+
+static const screen_t s_screens[] = {
+    {"splash", NULL, false},
+    {"menu_top", menu_top, false},
+    {"menu_last", menu_last, false},
+    {"mecanum_waiting", mecanum_waiting, false},
+    {"mecanum_driving", mecanum_driving, false},
+    {"mecanum_stick", mecanum_stick, true},
+    {"mecanum_telemetry", mecanum_telemetry, false},
+    {"mecanum_slow_loop", mecanum_slow_loop, false},
+    {"mecanum_back", mecanum_back, false},
+    {"rc_driving", rc_driving, false},
+    {"voice_listening", voice_listening, false},
+    {"settings_main", settings_main, false},
+    {"settings_brightness", settings_brightness, false},
+    {"settings_motor_cal", settings_motor_cal, false},
+};
+
+// ============================================================
+// LINK
+// ============================================================
+// A second of joystick traffic through the receive path, on the simulated
+// clock, so the telemetry page finds the controller and its link stats
+static void feed_link(void) {
+  event_bus_init();
+  hal_clock_host_set(1000000);
+  for (int i = 0; i < 20; i++) {
+    proto_joystick_msg_t msg = {.joy = {.throttle = 180}};
+    size_t len = proto_seal(&msg.hdr, PROTO_MSG_JOYSTICK, (uint16_t)i,
+                            (uint32_t)i * 50, sizeof(msg.joy));
+    espnow_handler_receive(s_remote_mac, -58, (const uint8_t *)&msg,
+                           (int)len);
+    hal_clock_host_advance(50000);
+  }
+  hal_clock_host_set(-1); // Render costs in real time
+}
+
+// ============================================================
+// MAIN
+// ============================================================
+static int write_pbm(const char *dir, const char *name) {
+  static uint8_t pbm[DISPLAY_PBM_MAX_BYTES];
+  char path[256];
+
+  size_t n = display_get_pbm(pbm, sizeof(pbm));
+  snprintf(path, sizeof(path), "%s/%s.pbm", dir, name);
+  FILE *f = fopen(path, "wb");
+  if (!f) {
+    perror(path);
+    return -1;
+  }
+  size_t written = fwrite(pbm, 1, n, f);
+  fclose(f);
+  return (written == n) ? 0 : -1;
+}
+
+// Pixels that differ from <dir>/<name>.pbm, -1 if it cannot be read
+static int compare_pbm(const char *dir, const char *name) {
+  static uint8_t pbm[DISPLAY_PBM_MAX_BYTES], ref[DISPLAY_PBM_MAX_BYTES + 1];
+  char path[256];
+
+  size_t n = display_get_pbm(pbm, sizeof(pbm));
+  snprintf(path, sizeof(path), "%s/%s.pbm", dir, name);
+  FILE *f = fopen(path, "rb");
+  if (!f) {
+    perror(path);
+    return -1;
+  }
+  size_t got = fread(ref, 1, sizeof(ref), f);
+  fclose(f);
+  if (got != n || memcmp(ref, pbm, n - OLED_WIDTH * OLED_HEIGHT / 8) != 0) {
+    fprintf(stderr, "%s: not a %dx%d PBM\n", path, OLED_WIDTH, OLED_HEIGHT);
+    return -1;
+  }
+
+  int diff = 0;
+  for (size_t i = n - OLED_WIDTH * OLED_HEIGHT / 8; i < n; i++) {
+    diff += __builtin_popcount(pbm[i] ^ ref[i]);
+  }
+  return diff;
+}
+
+// Loads <dir>/costs.txt into costs[]; returns the count, -1 on error
+static int load_costs(const char *dir, cost_t *costs, int max) {
+  char path[256], line[128];
+  snprintf(path, sizeof(path), "%s/costs.txt", dir);
+  FILE *f = fopen(path, "r");
+  if (!f) {
+    perror(path);
+    return -1;
+  }
+  int n = 0;
+  while (n < max && fgets(line, sizeof(line), f)) {
+    cost_t *c = &costs[n];
+    if (line[0] != '#' && sscanf(line, "%31s %u %u %u %u", c->name, &c->v[0],
+                                 &c->v[1], &c->v[2], &c->v[3]) == 5) {
+      n++;
+    }
+  }
+  fclose(f);
+  return n;
+}
+
+// Counts above the baseline for this screen; -1 if it has none
+static int compare_costs(const cost_t *costs, int n, const cost_t *now) {
+  for (int i = 0; i < n; i++) {
+    if (strcmp(costs[i].name, now->name) != 0) {
+      continue;
+    }
+    int worse = 0;
+    for (int k = 0; k < COST_COUNT; k++) {
+      if (now->v[k] > costs[i].v[k]) {
+        fprintf(stderr, "%s: %s rose from %u to %u\n", now->name,
+                s_cost_names[k], costs[i].v[k], now->v[k]);
+        worse++;
+      }
+    }
+    return worse;
+  }
+  fprintf(stderr, "%s: no baseline in costs.txt\n", now->name);
+  return -1;
+}
+
+int main(int argc, char **argv) {
+  bool check = (argc == 3 && strcmp(argv[1], "--check") == 0);
+  if (argc != 2 && !check) {
+    fprintf(stderr, "usage: %s <out_dir> | --check <golden_dir>\n",
+            argv[0]);
+    return 2;
+  }
+  const char *dir = argv[argc - 1];
+  const size_t count = sizeof(s_screens) / sizeof(s_screens[0]);
+  static cost_t baseline[sizeof(s_screens) / sizeof(s_screens[0])];
+  int baseline_n = 0;
+  FILE *costs_out = NULL;
+  int failed = 0;
+
+  if (check) {
+    baseline_n = load_costs(dir, baseline, (int)count);
+    if (baseline_n < 0) {
+      return 1;
+    }
+  } else {
+    char path[256];
+    snprintf(path, sizeof(path), "%s/costs.txt", dir);
+    costs_out = fopen(path, "w");
+    if (!costs_out) {
+      perror(path);
+      return 1;
+    }
+    fprintf(costs_out, "# screen pixels blit fill bytes (screen_dump)\n");
+  }
+
+  display_init();
+  feed_link();
+
+  printf("%-20s %7s %7s %7s %7s %7s\n", "screen", "pixels", "blit", "fill",
+         "us", "bytes");
+
+  for (size_t i = 0; i < count; i++) {
+    const screen_t *s = &s_screens[i];
+    display_flush_stats_t fs;
+    display_render_stats_t rs;
+
+    if (s->setup) {
+      s->setup();
+      if (!s->refresh) {
+        display_request_redraw();
+      }
+      display_service();
+    } else {
+      display_splash();
+    }
+
+    display_get_render_stats(&rs);
+    display_get_flush_stats(&fs);
+    printf("%-20s %7u %7u %7u %7u %7u\n", s->name, (unsigned)rs.pixel_calls,
+           (unsigned)rs.blit_cols, (unsigned)rs.fill_bytes,
+           (unsigned)rs.last_us, (unsigned)fs.last_bytes);
+
+    cost_t now = {.v = {rs.pixel_calls, rs.blit_cols, rs.fill_bytes,
+                        fs.last_bytes}};
+    snprintf(now.name, sizeof(now.name), "%s", s->name);
+
+    if (!check) {
+      fprintf(costs_out, "%-20s %7u %7u %7u %7u\n", now.name, now.v[0],
+              now.v[1], now.v[2], now.v[3]);
+      if (write_pbm(dir, s->name) != 0) {
+        fclose(costs_out);
+        return 1;
+      }
+      continue;
+    }
+    int diff = compare_pbm(dir, s->name);
+    if (diff > 0) {
+      fprintf(stderr, "%s: %d pixels differ from %s/%s.pbm\n", s->name, diff,
+              dir, s->name);
+    }
+    int worse = compare_costs(baseline, baseline_n, &now);
+    failed += (diff != 0 || worse != 0);
+  }
+
+  if (costs_out) {
+    return (fclose(costs_out) == 0) ? 0 : 1;
+  }
+  if (failed) {
+    fprintf(stderr, "%d screen(s) differ from the golden set\n", failed);
+  }
+  return failed ? 1 : 0;
+}
@@ -1,19 +1,19 @@
 /**
  * @file espnow_handler.c
- * @brief ESP-NOW receive handling for joystick and voice data
+ * @brief ESP-NOW driver glue and the transmit ring
+ *
+ * Received packets go to espnow_handler_receive() (espnow_rx.c), which
+ * does not depend on ESP-IDF and also runs in the host build.
  */
 
-#include "esp_log.h"
-#include "esp_now.h"
-#include "freertos/FreeRTOS.h"
-#include "freertos/task.h"
+#include <stdatomic.h>
 #include <string.h>
 
+#include "esp_log.h"
+#include "esp_now.h"
 
 #include "config.h"
 #include "espnow_handler.h"
-#include "types.h"
-
 
 static const char *TAG = "ESPNOW";
 
@@ -22,45 +22,112 @@ static const char *TAG = "ESPNOW";
 // ============================================================
 static void on_data_recv(const esp_now_recv_info_t *recv_info,
                          const uint8_t *data, int len) {
-  uint32_t now = xTaskGetTickCount() * portTICK_PERIOD_MS;
-
   ESP_LOGD(TAG, "Received %d bytes from " MACSTR, len,
            MAC2STR(recv_info->src_addr));
+  espnow_handler_receive(recv_info->src_addr, recv_info->rx_ctrl->rssi, data,
+                         len);
+}
 
-  // Check for joystick data (13 bytes = sizeof(joystick_data_t))
-  if (len == sizeof(joystick_data_t)) {
-    memcpy((void *)&g_ctx.joystick, data, sizeof(joystick_data_t));
-    g_ctx.last_joystick_time = now;
+// ============================================================
+// TRANSMIT RING
+// ============================================================
+// Filled by espnow_handler_send() on the executive; drained one message at
+// a time, each send started by the completion callback of the previous one
+// (WiFi task). A slot is released only when its send has completed.
+typedef struct {
+  uint8_t mac[ESP_NOW_ETH_ALEN];
+  uint8_t len;
+  uint8_t data[ESPNOW_TX_MAX_LEN];
+} tx_slot_t;
+
+static tx_slot_t s_tx_ring[ESPNOW_TX_RING_LEN];
+static atomic_uint s_tx_head; // Next slot to fill
+static atomic_uint s_tx_tail; // Slot in flight, or next to send
+static atomic_bool s_tx_busy; // A send is in flight
+static atomic_uint s_tx_queued, s_tx_dropped, s_tx_sent, s_tx_failed;
+
+static void tx_release(void) {
+  atomic_fetch_add_explicit(&s_tx_tail, 1, memory_order_release);
+  atomic_store_explicit(&s_tx_busy, false, memory_order_release);
+}
 
-    if (!g_ctx.joystick_connected) {
-      g_ctx.joystick_connected = true;
-      g_ctx.display_dirty = true;
-      ESP_LOGI(TAG, "Joystick connected");
+// Start the next send unless one is in flight (either task)
+static void tx_kick(void) {
+  while (!atomic_exchange_explicit(&s_tx_busy, true, memory_order_acquire)) {
+    unsigned tail = atomic_load_explicit(&s_tx_tail, memory_order_relaxed);
+    if (tail == atomic_load_explicit(&s_tx_head, memory_order_acquire)) {
+      atomic_store_explicit(&s_tx_busy, false, memory_order_release);
+      // A message queued after the check would otherwise wait
+      if (tail == atomic_load_explicit(&s_tx_head, memory_order_acquire))
+        return;
+      continue;
     }
 
-    ESP_LOGD(TAG, "Joystick: T=%d S=%d", g_ctx.joystick.throttle,
-             g_ctx.joystick.steering);
-    return;
+    const tx_slot_t *slot = &s_tx_ring[tail % ESPNOW_TX_RING_LEN];
+    if (esp_now_send(slot->mac, slot->data, slot->len) == ESP_OK)
+      return; // on_data_sent() releases the slot
+
+    atomic_fetch_add_explicit(&s_tx_failed, 1, memory_order_relaxed);
+    tx_release();
   }
+}
 
-  // Check for voice command (1 or 2 bytes)
-  if (len == 1 || len == 2) {
-    g_ctx.voice_cmd = data[0];
-    g_ctx.voice_speed = (len == 2) ? data[1] : VOICE_DEFAULT_SPEED;
-    g_ctx.last_voice_time = now;
+static void on_data_sent(const uint8_t *mac, esp_now_send_status_t status) {
+  (void)mac;
+  atomic_fetch_add_explicit(
+      (status == ESP_NOW_SEND_SUCCESS) ? &s_tx_sent : &s_tx_failed, 1,
+      memory_order_relaxed);
+  tx_release();
+  tx_kick();
+}
 
-    if (!g_ctx.voice_connected) {
-      g_ctx.voice_connected = true;
-      g_ctx.display_dirty = true;
-      ESP_LOGI(TAG, "Voice slave connected");
-    }
+static bool ensure_peer(const uint8_t mac[ESP_NOW_ETH_ALEN]) {
+  if (esp_now_is_peer_exist(mac)) {
+    return true;
+  }
 
-    ESP_LOGI(TAG, "Voice CMD: %d, Speed: %d", g_ctx.voice_cmd,
-             g_ctx.voice_speed);
-    return;
+  esp_now_peer_info_t peer = {
+      .channel = 0, // Current channel
+      .ifidx = WIFI_IF_STA,
+      .encrypt = false,
+  };
+  memcpy(peer.peer_addr, mac, ESP_NOW_ETH_ALEN);
+  esp_err_t ret = esp_now_add_peer(&peer);
+  if (ret != ESP_OK) {
+    ESP_LOGW(TAG, "Add peer " MACSTR " failed: %s", MAC2STR(mac),
+             esp_err_to_name(ret));
+    return false;
+  }
+  ESP_LOGI(TAG, "Added peer " MACSTR, MAC2STR(mac));
+  return true;
+}
+
+bool espnow_handler_send(const uint8_t mac[6], const void *data, size_t len) {
+  unsigned head = atomic_load_explicit(&s_tx_head, memory_order_relaxed);
+  unsigned tail = atomic_load_explicit(&s_tx_tail, memory_order_acquire);
+
+  if (len > ESPNOW_TX_MAX_LEN || head - tail >= ESPNOW_TX_RING_LEN ||
+      !ensure_peer(mac)) {
+    atomic_fetch_add_explicit(&s_tx_dropped, 1, memory_order_relaxed);
+    return false;
   }
 
-  ESP_LOGW(TAG, "Unknown packet size: %d", len);
+  tx_slot_t *slot = &s_tx_ring[head % ESPNOW_TX_RING_LEN];
+  memcpy(slot->mac, mac, ESP_NOW_ETH_ALEN);
+  memcpy(slot->data, data, len);
+  slot->len = (uint8_t)len;
+  atomic_store_explicit(&s_tx_head, head + 1, memory_order_release);
+  atomic_fetch_add_explicit(&s_tx_queued, 1, memory_order_relaxed);
+
+  tx_kick();
+  return true;
+}
+
+void espnow_handler_get_tx_stats(espnow_tx_stats_t *out) {
+  out->queued = atomic_load_explicit(&s_tx_queued, memory_order_relaxed);
+  out->dropped = atomic_load_explicit(&s_tx_dropped, memory_order_relaxed);
+  out->sent = atomic_load_explicit(&s_tx_sent, memory_order_relaxed);
+  out->failed = atomic_load_explicit(&s_tx_failed, memory_order_relaxed);
 }
 
 // ============================================================
@@ -81,5 +148,14 @@ void espnow_handler_init(void) {
     return;
   }
 
+  // Completion of queued sends (drives the transmit ring)
+  ret = esp_now_register_send_cb(on_data_sent);
+  if (ret != ESP_OK) {
+    ESP_LOGE(TAG, "Failed to register send callback: %s",
+             esp_err_to_name(ret));
+    return;
+  }
+
   ESP_LOGI(TAG, "ESP-NOW handler initialized");
 }
+
@@ -1,14 +1,78 @@
 /**
  * @file espnow_handler.h
- * @brief ESP-NOW receive handling
+ * @brief ESP-NOW receive handling and the transmit ring
  */
 
 #ifndef ESPNOW_HANDLER_H
 #define ESPNOW_HANDLER_H
 
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Transmit ring counters
+ */
+typedef struct {
+  uint32_t queued;  // Accepted by espnow_handler_send()
+  uint32_t dropped; // Ring full or message too long
+  uint32_t sent;    // Acknowledged by the peer
+  uint32_t failed;  // Rejected or not acknowledged
+} espnow_tx_stats_t;
+
 /**
  * @brief Initialize ESP-NOW handler
  */
 void espnow_handler_init(void);
 
+/**
+ * @brief Decode and dispatch one received packet
+ *
+ * Called from the ESP-NOW receive callback (WiFi task); also fed directly
+ * by host tests. Publishes and posts only, never blocks.
+ *
+ * @param src Sender address
+ * @param rssi Signal strength (dBm)
+ * @param data Packet
+ * @param len Packet size
+ */
+void espnow_handler_receive(const uint8_t src[6], int8_t rssi,
+                            const uint8_t *data, int len);
+
+/**
+ * @brief Set a function called after each accepted input packet
+ *
+ * Runs on the WiFi task; it must be short and must not block.
+ *
+ * @param hook Callback, or NULL to disable
+ */
+void espnow_handler_set_rx_hook(void (*hook)(void));
+
+/**
+ * @brief Queue a message for a peer (never blocks)
+ *
+ * The message is copied into a preallocated ring slot, which is held until
+ * ESP-NOW reports the result of the send. The peer is added on first use.
+ * Single producer: call from the executive only.
+ *
+ * @param mac Destination address
+ * @param data Message
+ * @param len Message size (at most ESPNOW_TX_MAX_LEN)
+ * @return false if the message was dropped
+ */
+bool espnow_handler_send(const uint8_t mac[6], const void *data, size_t len);
+
+/**
+ * @brief Address of the controller that sent the latest joystick message
+ * @param mac Destination
+ * @return false if no joystick message has been received
+ */
+bool espnow_handler_get_controller(uint8_t mac[6]);
+
+/**
+ * @brief Get transmit ring counters
+ * @param out Destination
+ */
+void espnow_handler_get_tx_stats(espnow_tx_stats_t *out);
+
 #endif // ESPNOW_HANDLER_H
@@ -0,0 +1,150 @@
+/**
+ * @file espnow_rx.c
+ * @brief Decoding and dispatch of received radio messages
+ *
+ * Messages use the protocol.h framing and are dispatched by type through
+ * s_handlers. Bare 1-2 byte voice commands are still accepted.
+ */
+
+#include <stdatomic.h>
+#include <string.h>
+
+#include "config.h"
+#include "espnow_handler.h"
+#include "event_bus.h"
+#include "hal_clock.h"
+#include "hal_log.h"
+#include "input_snapshot.h"
+#include "link_stats.h"
+#include "protocol.h"
+#include "seqlock.h"
+#include "types.h"
+
+static const char *TAG = "ESPNOW";
+
+static void (*s_rx_hook)(void) = NULL;
+
+// Sender of the latest joystick message (WiFi task writes)
+typedef union {
+  uint8_t mac[6];
+  uint32_t words[SEQLOCK_WORDS(uint8_t[6])];
+} mac_buf_t;
+
+static atomic_uint s_controller_seq;
+static atomic_uint s_controller[SEQLOCK_WORDS(mac_buf_t)];
+static atomic_bool s_have_controller;
+
+// ============================================================
+// MESSAGE HANDLERS
+// ============================================================
+// Run on the WiFi task: publish and post only, never touch g_ctx or block.
+// Payloads are read in place from the receive buffer.
+typedef void (*msg_handler_fn)(const void *payload, int64_t now_us,
+                               const uint8_t *src);
+
+typedef struct {
+  uint16_t length; // Minimum payload (newer senders may append fields)
+  msg_handler_fn fn;
+} msg_handler_t;
+
+static void publish_joystick(const proto_joystick_t *msg, int64_t now_us,
+                             const uint8_t *src) {
+  joystick_data_t joy = {
+      .throttle = msg->throttle,
+      .steering = msg->steering,
+      .aux_x = msg->aux_x,
+      .aux_y = msg->aux_y,
+      .btn1 = (msg->buttons & PROTO_BTN1) != 0,
+      .btn2 = (msg->buttons & PROTO_BTN2) != 0,
+      .mode = msg->mode,
+  };
+
+  mac_buf_t from = {0};
+  memcpy(from.mac, src, 6);
+  seqlock_write(&s_controller_seq, s_controller, from.words,
+                SEQLOCK_WORDS(mac_buf_t));
+  atomic_store_explicit(&s_have_controller, true, memory_order_release);
+
+  input_snapshot_publish_joystick(&joy, now_us);
+  event_bus_post_joystick(&joy);
+}
+
+static void on_joystick(const void *payload, int64_t now_us,
+                        const uint8_t *src) {
+  publish_joystick(payload, now_us, src);
+}
+
+static void on_joystick_compact(const void *payload, int64_t now_us,
+                                const uint8_t *src) {
+  proto_joystick_t msg;
+  proto_joystick_unpack(payload, &msg);
+  publish_joystick(&msg, now_us, src);
+}
+
+static void on_voice(const void *payload, int64_t now_us,
+                     const uint8_t *src) {
+  const proto_voice_t *msg = payload;
+  (void)src;
+  input_snapshot_publish_voice(msg->cmd, msg->speed, now_us);
+  event_bus_post_voice(msg->cmd, msg->speed);
+}
+
+static const msg_handler_t s_handlers[PROTO_MSG_COUNT] = {
+    [PROTO_MSG_JOYSTICK] = {sizeof(proto_joystick_t), on_joystick},
+    [PROTO_MSG_JOYSTICK_COMPACT] = {sizeof(proto_joystick_compact_t),
+                                    on_joystick_compact},
+    [PROTO_MSG_VOICE] = {sizeof(proto_voice_t), on_voice},
+};
+
+// ============================================================
+// RECEIVE
+// ============================================================
+void espnow_handler_receive(const uint8_t src[6], int8_t rssi,
+                            const uint8_t *data, int len) {
+  int64_t now_us = hal_time_us();
+  const proto_header_t *hdr;
+  proto_status_t status = proto_parse(data, len, &hdr);
+  if (status == PROTO_OK) {
+    const msg_handler_t *h =
+        (hdr->type < PROTO_MSG_COUNT) ? &s_handlers[hdr->type] : NULL;
+    if (!h || !h->fn || hdr->length < h->length) {
+      ESP_LOGW(TAG, "Unknown message type %d (%d bytes)", hdr->type,
+               hdr->length);
+      return;
+    }
+    if (!link_stats_record(src, hdr->seq, hdr->timestamp_ms, now_us,
+                           rssi)) {
+      return; // Duplicate (retransmission)
+    }
+    h->fn(proto_payload(hdr), now_us, src);
+    if (s_rx_hook)
+      s_rx_hook();
+    return;
+  }
+
+  // Legacy voice module: bare command byte, optional speed byte
+  if (len == 1 || len == 2) {
+    uint8_t speed = (len == 2) ? data[1] : VOICE_DEFAULT_SPEED;
+    input_snapshot_publish_voice(data[0], speed, now_us);
+    event_bus_post_voice(data[0], speed);
+    if (s_rx_hook)
+      s_rx_hook();
+    return;
+  }
+
+  ESP_LOGW(TAG, "Dropped %d byte packet (status %d)", len, status);
+}
+
+bool espnow_handler_get_controller(uint8_t mac[6]) {
+  if (!atomic_load_explicit(&s_have_controller, memory_order_acquire)) {
+    return false;
+  }
+
+  mac_buf_t buf;
+  seqlock_read(&s_controller_seq, s_controller, buf.words,
+               SEQLOCK_WORDS(mac_buf_t));
+  memcpy(mac, buf.mac, 6);
+  return true;
+}
+
+void espnow_handler_set_rx_hook(void (*hook)(void)) { s_rx_hook = hook; }
@@ -0,0 +1,88 @@
+/**
+ * @file input_snapshot.c
+ * @brief Seqlock-protected input snapshots
+ */
+
+#include "input_snapshot.h"
+#include "seqlock.h"
+
+typedef struct {
+  atomic_uint seq; // Odd while a write is in progress
+  atomic_uint words[SEQLOCK_WORDS(joystick_frame_t)];
+} joystick_slot_t;
+
+typedef struct {
+  atomic_uint seq;
+  atomic_uint words[SEQLOCK_WORDS(voice_frame_t)];
+} voice_slot_t;
+
+static joystick_slot_t s_joystick;
+static voice_slot_t s_voice;
+
+// ============================================================
+// JOYSTICK
+// ============================================================
+void input_snapshot_publish_joystick(const joystick_data_t *data,
+                                     int64_t stamp_us) {
+  // Sole writer: the current count can be read without the lock
+  unsigned s = atomic_load_explicit(&s_joystick.seq, memory_order_relaxed);
+
+  union {
+    joystick_frame_t frame;
+    uint32_t words[SEQLOCK_WORDS(joystick_frame_t)];
+  } buf = {0};
+  buf.frame.data = *data;
+  buf.frame.count = s / 2 + 1;
+  buf.frame.stamp_us = stamp_us;
+
+  seqlock_write(&s_joystick.seq, s_joystick.words, buf.words,
+                SEQLOCK_WORDS(joystick_frame_t));
+}
+
+bool input_snapshot_read_joystick(joystick_frame_t *out) {
+  union {
+    joystick_frame_t frame;
+    uint32_t words[SEQLOCK_WORDS(joystick_frame_t)];
+  } buf;
+
+  if (!seqlock_read(&s_joystick.seq, s_joystick.words, buf.words,
+                    SEQLOCK_WORDS(joystick_frame_t))) {
+    return false;
+  }
+  *out = buf.frame;
+  return true;
+}
+
+// ============================================================
+// VOICE
+// ============================================================
+void input_snapshot_publish_voice(uint8_t cmd, uint8_t speed,
+                                  int64_t stamp_us) {
+  unsigned s = atomic_load_explicit(&s_voice.seq, memory_order_relaxed);
+
+  union {
+    voice_frame_t frame;
+    uint32_t words[SEQLOCK_WORDS(voice_frame_t)];
+  } buf = {0};
+  buf.frame.cmd = cmd;
+  buf.frame.speed = speed;
+  buf.frame.count = s / 2 + 1;
+  buf.frame.stamp_us = stamp_us;
+
+  seqlock_write(&s_voice.seq, s_voice.words, buf.words,
+                SEQLOCK_WORDS(voice_frame_t));
+}
+
+bool input_snapshot_read_voice(voice_frame_t *out) {
+  union {
+    voice_frame_t frame;
+    uint32_t words[SEQLOCK_WORDS(voice_frame_t)];
+  } buf;
+
+  if (!seqlock_read(&s_voice.seq, s_voice.words, buf.words,
+                    SEQLOCK_WORDS(voice_frame_t))) {
+    return false;
+  }
+  *out = buf.frame;
+  return true;
+}
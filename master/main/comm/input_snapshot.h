@@ -0,0 +1,73 @@
+/**
+ * @file input_snapshot.h
+ * @brief Lock-free latest-value snapshots of remote input
+ *
+ * The radio callback publishes each received frame. The dispatcher gets
+ * frames through the event bus (in order, replayable); the snapshots let
+ * any other task read the newest input without the queue or g_ctx. A
+ * sequence counter (seqlock) guards each snapshot:
+ * the writer never waits, and a reader retries until it has copied a frame
+ * that no write overlapped, so it never sees half of an update.
+ *
+ * One writer per snapshot, any number of readers.
+ */
+
+#ifndef INPUT_SNAPSHOT_H
+#define INPUT_SNAPSHOT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "types.h"
+
+/**
+ * @brief Consistent joystick frame as seen by a consumer
+ */
+typedef struct {
+  joystick_data_t data;
+  uint32_t count;    // Frames published so far (1 = first frame)
+  int64_t stamp_us;  // Arrival time
+} joystick_frame_t;
+
+/**
+ * @brief Consistent voice frame as seen by a consumer
+ */
+typedef struct {
+  uint8_t cmd;
+  uint8_t speed;
+  uint32_t count;
+  int64_t stamp_us;
+} voice_frame_t;
+
+/**
+ * @brief Publish a joystick frame (single producer, never blocks)
+ * @param data Received joystick data
+ * @param stamp_us Arrival time in microseconds
+ */
+void input_snapshot_publish_joystick(const joystick_data_t *data,
+                                     int64_t stamp_us);
+
+/**
+ * @brief Read the latest joystick frame
+ * @param out Destination
+ * @return false if nothing has been published yet
+ */
+bool input_snapshot_read_joystick(joystick_frame_t *out);
+
+/**
+ * @brief Publish a voice command (single producer, never blocks)
+ * @param cmd Voice command
+ * @param speed Requested speed
+ * @param stamp_us Arrival time in microseconds
+ */
+void input_snapshot_publish_voice(uint8_t cmd, uint8_t speed,
+                                  int64_t stamp_us);
+
+/**
+ * @brief Read the latest voice frame
+ * @param out Destination
+ * @return false if nothing has been published yet
+ */
+bool input_snapshot_read_voice(voice_frame_t *out);
+
+#endif // INPUT_SNAPSHOT_H
@@ -0,0 +1,258 @@
+/**
+ * @file link_stats.c
+ * @brief Per-peer radio link statistics implementation
+ *
+ * The writer keeps the working state of each peer privately and publishes
+ * the public counters through the peer's seqlock after every message.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "config.h"
+#include "hal_log.h"
+#include "link_stats.h"
+#include "seqlock.h"
+
+static const char *TAG = "LINK";
+
+#define SEQ_WINDOW 32     // Late messages tracked behind the newest
+#define SEQ_MAX_JUMP 1000 // Larger forward jumps are a restart
+#define SEQ_MAX_DELAY_MS 100 // Extra transit a late message can have
+#define RSSI_EWMA_SHIFT 3 // EWMA weight 1/8
+
+const uint16_t link_jitter_bin_ms[LINK_JITTER_BINS - 1] = {1,  2,  5,  10,
+                                                           20, 50, 100};
+
+typedef struct {
+  atomic_uint seq;
+  atomic_uint words[SEQLOCK_WORDS(link_peer_stats_t)];
+} peer_slot_t;
+
+// Writer-only working state
+typedef struct {
+  link_peer_stats_t pub; // Published counters
+  uint32_t window;       // Bit n: sequence pub.seq - n received
+  uint32_t prev_ms;      // Sender time of the previous in-order message
+  int64_t prev_us;       // Its arrival
+} peer_state_t;
+
+static peer_state_t s_state[LINK_MAX_PEERS];
+static peer_slot_t s_slots[LINK_MAX_PEERS];
+static atomic_int s_peer_count;
+static atomic_int s_latest = -1;
+
+// ============================================================
+// WRITER
+// ============================================================
+static peer_state_t *find_peer(const uint8_t mac[6], int *idx) {
+  int n = atomic_load_explicit(&s_peer_count, memory_order_relaxed);
+
+  for (int i = 0; i < n; i++) {
+    if (memcmp(s_state[i].pub.mac, mac, 6) == 0) {
+      *idx = i;
+      return &s_state[i];
+    }
+  }
+  if (n == LINK_MAX_PEERS) {
+    return NULL;
+  }
+
+  memset(&s_state[n], 0, sizeof(s_state[n]));
+  memcpy(s_state[n].pub.mac, mac, 6);
+  *idx = n;
+  return &s_state[n];
+}
+
+static void record_jitter(peer_state_t *st, uint32_t sender_ms,
+                          int64_t now_us) {
+  if (st->prev_us) {
+    int64_t arrival = now_us - st->prev_us;
+    int64_t sent = (int64_t)(uint32_t)(sender_ms - st->prev_ms) * 1000;
+    uint32_t d = (uint32_t)llabs(arrival - sent);
+
+    // J += (|D| - J) / 16
+    st->pub.jitter_us =
+        (uint32_t)((int64_t)st->pub.jitter_us +
+                   ((int64_t)d - (int64_t)st->pub.jitter_us) / 16);
+
+    int bin = 0;
+    while (bin < LINK_JITTER_BINS - 1 && d > link_jitter_bin_ms[bin] * 1000u)
+      bin++;
+    st->pub.jitter_hist[bin]++;
+  }
+  st->prev_ms = sender_ms;
+  st->prev_us = now_us;
+}
+
+// A message sent before the newest one arrives at most SEQ_MAX_DELAY_MS
+// later than its place in the sender's timeline allows. A sender clock
+// further behind than that has restarted, whatever the sequence number
+// says (a quick reboot lands inside the reorder window).
+static bool sender_restarted(const peer_state_t *st, uint32_t sender_ms,
+                             int64_t now_us) {
+  int32_t behind_ms = (int32_t)(st->prev_ms - sender_ms);
+  if (!st->prev_us || behind_ms <= 0) {
+    return false;
+  }
+  int64_t extra_us = (int64_t)behind_ms * 1000 + (now_us - st->prev_us);
+  return extra_us > SEQ_MAX_DELAY_MS * 1000;
+}
+
+static void resync(peer_state_t *st, uint16_t seq, uint32_t sender_ms,
+                   int64_t now_us) {
+  st->pub.resyncs++;
+  st->pub.seq = seq;
+  st->window = 1;
+  st->prev_us = 0;
+  record_jitter(st, sender_ms, now_us);
+}
+
+// Returns false for duplicates
+static bool track_seq(peer_state_t *st, uint16_t seq, uint32_t sender_ms,
+                      int64_t now_us) {
+  link_peer_stats_t *pub = &st->pub;
+  int16_t diff = (int16_t)(seq - st->pub.seq);
+
+  if (pub->packets == 0) {
+    st->pub.seq = seq;
+    st->window = 1;
+    record_jitter(st, sender_ms, now_us);
+    return true;
+  }
+  if (sender_restarted(st, sender_ms, now_us)) {
+    resync(st, seq, sender_ms, now_us);
+    return true;
+  }
+
+  if (diff > 0 && diff <= SEQ_MAX_JUMP) {
+    pub->lost += (uint32_t)(diff - 1);
+    st->window = (diff >= SEQ_WINDOW) ? 1 : (st->window << diff) | 1;
+    st->pub.seq = seq;
+    record_jitter(st, sender_ms, now_us);
+    return true;
+  }
+  if (diff == 0) {
+    pub->duplicates++;
+    return false;
+  }
+  if (diff < 0 && -diff < SEQ_WINDOW) {
+    uint32_t bit = 1u << -diff;
+    if (st->window & bit) {
+      pub->duplicates++;
+      return false;
+    }
+    // Counted as lost when the newer one arrived
+    st->window |= bit;
+    pub->reordered++;
+    if (pub->lost)
+      pub->lost--;
+    return true;
+  }
+
+  // Sender restarted (or a jump we cannot account for)
+  resync(st, seq, sender_ms, now_us);
+  return true;
+}
+
+bool link_stats_record(const uint8_t mac[6], uint16_t seq, uint32_t sender_ms,
+                       int64_t now_us, int8_t rssi) {
+  int idx;
+  peer_state_t *st = find_peer(mac, &idx);
+  if (!st) {
+    return true; // Table full: accept, but keep no statistics
+  }
+
+  bool fresh = track_seq(st, seq, sender_ms, now_us);
+
+  link_peer_stats_t *pub = &st->pub;
+  if (pub->packets == 0 && pub->duplicates == 0) {
+    pub->rssi_avg_q4 = (int16_t)(rssi * 16);
+  } else {
+    pub->rssi_avg_q4 += (int16_t)((rssi * 16 - pub->rssi_avg_q4) >>
+                                  RSSI_EWMA_SHIFT);
+  }
+  pub->rssi = rssi;
+  pub->last_us = now_us;
+  if (fresh)
+    pub->packets++;
+
+  seqlock_write(&s_slots[idx].seq, s_slots[idx].words, pub,
+                SEQLOCK_WORDS(link_peer_stats_t));
+
+  // A new peer becomes visible once its slot holds data
+  if (idx == atomic_load_explicit(&s_peer_count, memory_order_relaxed))
+    atomic_store_explicit(&s_peer_count, idx + 1, memory_order_release);
+  atomic_store_explicit(&s_latest, idx, memory_order_release);
+  return fresh;
+}
+
+// ============================================================
+// READERS
+// ============================================================
+int link_stats_peer_count(void) {
+  return atomic_load_explicit(&s_peer_count, memory_order_acquire);
+}
+
+bool link_stats_get_peer(int idx, link_peer_stats_t *out) {
+  if (idx < 0 || idx >= link_stats_peer_count()) {
+    return false;
+  }
+
+  union {
+    link_peer_stats_t stats;
+    uint32_t words[SEQLOCK_WORDS(link_peer_stats_t)];
+  } buf;
+  seqlock_read(&s_slots[idx].seq, s_slots[idx].words, buf.words,
+               SEQLOCK_WORDS(link_peer_stats_t));
+  *out = buf.stats;
+  return true;
+}
+
+bool link_stats_find(const uint8_t mac[6], link_peer_stats_t *out) {
+  int n = link_stats_peer_count();
+
+  for (int i = 0; i < n; i++) {
+    // The address of a visible slot never changes
+    if (memcmp(s_state[i].pub.mac, mac, 6) == 0) {
+      return link_stats_get_peer(i, out);
+    }
+  }
+  return false;
+}
+
+bool link_stats_get_latest(link_peer_stats_t *out) {
+  return link_stats_get_peer(
+      atomic_load_explicit(&s_latest, memory_order_acquire), out);
+}
+
+bool link_stats_weak(const uint8_t mac[6]) {
+  link_peer_stats_t st;
+  return link_stats_find(mac, &st) &&
+         st.rssi_avg_q4 < LINK_RSSI_WEAK_DBM * 16;
+}
+
+void link_stats_log(void) {
+  int n = link_stats_peer_count();
+
+  for (int i = 0; i < n; i++) {
+    link_peer_stats_t st;
+    link_stats_get_peer(i, &st);
+    ESP_LOGI(TAG,
+             "%02x:%02x:%02x:%02x:%02x:%02x pkts=%lu lost=%lu dup=%lu "
+             "reord=%lu resync=%lu rssi=%d avg=%d jitter=%lu us",
+             st.mac[0], st.mac[1], st.mac[2], st.mac[3], st.mac[4],
+             st.mac[5], (unsigned long)st.packets, (unsigned long)st.lost,
+             (unsigned long)st.duplicates, (unsigned long)st.reordered,
+             (unsigned long)st.resyncs, st.rssi, st.rssi_avg_q4 / 16,
+             (unsigned long)st.jitter_us);
+    ESP_LOGI(TAG,
+             "  jitter <=1:%lu <=2:%lu <=5:%lu <=10:%lu <=20:%lu "
+             "<=50:%lu <=100:%lu >100:%lu ms",
+             (unsigned long)st.jitter_hist[0], (unsigned long)st.jitter_hist[1],
+             (unsigned long)st.jitter_hist[2], (unsigned long)st.jitter_hist[3],
+             (unsigned long)st.jitter_hist[4], (unsigned long)st.jitter_hist[5],
+             (unsigned long)st.jitter_hist[6],
+             (unsigned long)st.jitter_hist[7]);
+  }
+}
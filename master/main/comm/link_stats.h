@@ -0,0 +1,101 @@
+/**
+ * @file link_stats.h
+ * @brief Per-peer radio link statistics
+ *
+ * The radio callback records every protocol message; the UI, the console
+ * and loggers read consistent per-peer snapshots at any time. Each peer
+ * record sits behind a seqlock (seqlock.h), so the callback never waits
+ * for a reader.
+ *
+ * Sequence numbers give loss, duplicates and reordering (a 32-message
+ * window behind the newest one); a sender timestamp that goes back
+ * further than a late message could be marks a restart. Jitter is the RFC 3550 transit-time
+ * variation: the change of arrival spacing against the sender's
+ * timestamps, so it does not depend on the send rate.
+ */
+
+#ifndef LINK_STATS_H
+#define LINK_STATS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define LINK_JITTER_BINS 8
+
+/**
+ * @brief Upper bounds (ms) of the jitter histogram bins; the last bin is
+ *        everything above the final bound
+ */
+extern const uint16_t link_jitter_bin_ms[LINK_JITTER_BINS - 1];
+
+/**
+ * @brief Counters of one peer since its first message
+ */
+typedef struct {
+  uint8_t mac[6];
+  int8_t rssi;                            // Latest (dBm)
+  int16_t rssi_avg_q4;                    // EWMA (dBm, Q4)
+  uint16_t seq;                           // Newest sequence number
+  uint32_t packets;                       // Messages accepted
+  uint32_t lost;                          // Sequence numbers never seen
+  uint32_t duplicates;                    // Sequence numbers seen again
+  uint32_t reordered;                     // Arrived behind a newer one
+  uint32_t resyncs;                       // Sequence restarts
+  uint32_t jitter_us;                     // Smoothed transit variation
+  uint32_t jitter_hist[LINK_JITTER_BINS]; // |transit change| per message
+  int64_t last_us;                        // Arrival of the latest message
+} link_peer_stats_t;
+
+/**
+ * @brief Record one received message (radio callback, single writer)
+ * @param mac Sender address
+ * @param seq Message sequence number
+ * @param sender_ms Sender timestamp
+ * @param now_us Arrival time
+ * @param rssi Received signal strength (dBm)
+ * @return false if the message is a duplicate (drop it)
+ */
+bool link_stats_record(const uint8_t mac[6], uint16_t seq, uint32_t sender_ms,
+                       int64_t now_us, int8_t rssi);
+
+/**
+ * @brief Number of peers seen so far
+ */
+int link_stats_peer_count(void);
+
+/**
+ * @brief Read one peer's counters
+ * @param idx Peer index, 0 .. link_stats_peer_count() - 1
+ * @param out Destination
+ * @return false if idx is out of range
+ */
+bool link_stats_get_peer(int idx, link_peer_stats_t *out);
+
+/**
+ * @brief Read the counters of one sender
+ * @param mac Sender address
+ * @param out Destination
+ * @return false if nothing has been received from it
+ */
+bool link_stats_find(const uint8_t mac[6], link_peer_stats_t *out);
+
+/**
+ * @brief Read the counters of the peer that sent the latest message
+ * @param out Destination
+ * @return false if nothing has been received
+ */
+bool link_stats_get_latest(link_peer_stats_t *out);
+
+/**
+ * @brief True when a sender's averaged RSSI is below LINK_RSSI_WEAK_DBM
+ *        (a dropout is likely)
+ * @param mac Sender address
+ */
+bool link_stats_weak(const uint8_t mac[6]);
+
+/**
+ * @brief Log every peer's counters
+ */
+void link_stats_log(void);
+
+#endif // LINK_STATS_H
@@ -0,0 +1,66 @@
+/**
+ * @file seqlock.h
+ * @brief Single-writer sequence lock over word arrays
+ *
+ * The writer never waits; a reader retries until it has copied a value no
+ * write overlapped. Storage is an array of relaxed atomic words rather than
+ * a plain struct, so the racing copy in the reader is well defined; the
+ * sequence counter and fences decide whether the copy is kept.
+ */
+
+#ifndef SEQLOCK_H
+#define SEQLOCK_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+// Words needed to hold a T
+#define SEQLOCK_WORDS(T) ((sizeof(T) + sizeof(uint32_t) - 1) / sizeof(uint32_t))
+
+// ============================================================
+// PRIMITIVES
+// ============================================================
+static inline void seqlock_write(atomic_uint *seq, atomic_uint *words,
+                                 const void *src, size_t n_words) {
+  unsigned s = atomic_load_explicit(seq, memory_order_relaxed);
+  atomic_store_explicit(seq, s + 1, memory_order_relaxed);
+  atomic_thread_fence(memory_order_release);
+
+  const uint8_t *p = src;
+  for (size_t i = 0; i < n_words; i++) {
+    uint32_t w;
+    memcpy(&w, p + i * sizeof(w), sizeof(w));
+    atomic_store_explicit(&words[i], w, memory_order_relaxed);
+  }
+
+  atomic_store_explicit(seq, s + 2, memory_order_release);
+}
+
+// Returns false if nothing was ever written
+static inline bool seqlock_read(atomic_uint *seq, atomic_uint *words,
+                                void *dst, size_t n_words) {
+  uint8_t *p = dst;
+  unsigned s1, s2;
+
+  do {
+    s1 = atomic_load_explicit(seq, memory_order_acquire);
+    if (s1 & 1) {
+      continue; // Writer active
+    }
+
+    for (size_t i = 0; i < n_words; i++) {
+      uint32_t w = atomic_load_explicit(&words[i], memory_order_relaxed);
+      memcpy(p + i * sizeof(w), &w, sizeof(w));
+    }
+
+    atomic_thread_fence(memory_order_acquire);
+    s2 = atomic_load_explicit(seq, memory_order_relaxed);
+  } while ((s1 & 1) || s1 != s2);
+
+  return s1 != 0;
+}
+
+#endif // SEQLOCK_H
@@ -0,0 +1,78 @@
+/**
+ * @file telemetry_tx.c
+ * @brief Telemetry frames back to the active controller
+ */
+
+#include "hal_log.h"
+
+#include "config.h"
+#include "espnow_handler.h"
+#include "hal_clock.h"
+#include "link_stats.h"
+#include "motor.h"
+#include "protocol.h"
+#include "scheduler.h"
+#include "telemetry_tx.h"
+#include "types.h"
+
+static const char *TAG = "TLM_TX";
+
+// Built in place; the transmit ring takes a copy
+static proto_telemetry_msg_t s_msg;
+static uint16_t s_seq = 0;
+
+static uint16_t saturate_u16(uint32_t v) {
+  return (v > UINT16_MAX) ? UINT16_MAX : (uint16_t)v;
+}
+
+// ============================================================
+// FRAME
+// ============================================================
+void telemetry_tx_step(void) {
+  uint8_t mac[6];
+
+  // Only while the controller is being heard: it is listening then
+  if (!g_ctx.joystick_connected || !espnow_handler_get_controller(mac)) {
+    return;
+  }
+
+  link_peer_stats_t ls = {0};
+  link_stats_find(mac, &ls);
+  // What the wheels are driven at, not the mode's unramped targets
+  motor_speeds_t out;
+  motor_get_applied(&out);
+
+  proto_telemetry_t *t = &s_msg.tlm;
+  t->state = (uint8_t)g_ctx.current_state;
+  t->movement = (uint8_t)g_ctx.movement;
+  t->flags = (g_ctx.estop_latched ? PROTO_TLM_ESTOP : 0) |
+             (g_ctx.joystick_connected ? PROTO_TLM_JOY : 0) |
+             (g_ctx.voice_connected ? PROTO_TLM_VOICE : 0);
+  t->rssi = (int8_t)(ls.rssi_avg_q4 / 16);
+  t->duty[0] = out.fl;
+  t->duty[1] = out.fr;
+  t->duty[2] = out.bl;
+  t->duty[3] = out.br;
+  t->ack_seq = ls.seq;
+  t->rx_packets = (uint16_t)ls.packets;
+  t->rx_lost = (uint16_t)ls.lost;
+  t->jitter_us = saturate_u16(ls.jitter_us);
+
+  size_t len = proto_seal(&s_msg.hdr, PROTO_MSG_TELEMETRY, s_seq++,
+                          (uint32_t)(hal_time_us() / 1000), sizeof(*t));
+  espnow_handler_send(mac, &s_msg, len);
+}
+
+// ============================================================
+// INITIALIZATION
+// ============================================================
+void telemetry_tx_init(void) {
+#if TELEMETRY_TX_PERIOD_MS > 0
+  scheduler_add_group("telemetry", TELEMETRY_TX_PERIOD_MS * 1000,
+                      telemetry_tx_step);
+  ESP_LOGI(TAG, "Telemetry to the controller every %d ms",
+           TELEMETRY_TX_PERIOD_MS);
+#else
+  ESP_LOGI(TAG, "Telemetry to the controller disabled");
+#endif
+}
@@ -0,0 +1,24 @@
+/**
+ * @file telemetry_tx.h
+ * @brief Telemetry frames back to the active controller
+ *
+ * Every TELEMETRY_TX_PERIOD_MS the master reports its state, movement,
+ * wheel duties, the emergency stop latch and how it receives the
+ * controller (proto_telemetry_t) to the sender of the latest joystick
+ * message, through the espnow_handler transmit ring.
+ */
+
+#ifndef TELEMETRY_TX_H
+#define TELEMETRY_TX_H
+
+/**
+ * @brief Register the telemetry rate group (nothing if the period is 0)
+ */
+void telemetry_tx_init(void);
+
+/**
+ * @brief Build and queue one frame (executive task only)
+ */
+void telemetry_tx_step(void);
+
+#endif // TELEMETRY_TX_H
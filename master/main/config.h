@@ -66,6 +66,24 @@
 #define MOTOR_CH_BL LEDC_CHANNEL_2
 #define MOTOR_CH_BR LEDC_CHANNEL_3
 
+// PWM backend, selectable at build time (-DMOTOR_PWM_BACKEND=...)
+#define MOTOR_PWM_BACKEND_LEDC 0  // 8-bit, channels latched one by one
+#define MOTOR_PWM_BACKEND_MCPWM 1 // ~12-bit, all wheels latch on timer zero
+#ifndef MOTOR_PWM_BACKEND
+#define MOTOR_PWM_BACKEND MOTOR_PWM_BACKEND_LEDC
+#endif
+
+// MCPWM: 80 MHz / 20 kHz = 4000 ticks per period
+#define MOTOR_MCPWM_RES_HZ 80000000
+#define MOTOR_MCPWM_PERIOD_TICKS (MOTOR_MCPWM_RES_HZ / MOTOR_PWM_FREQ)
+
+// Full-scale duty of the selected backend
+#if MOTOR_PWM_BACKEND == MOTOR_PWM_BACKEND_MCPWM
+#define MOTOR_PWM_MAX_DUTY MOTOR_MCPWM_PERIOD_TICKS
+#else
+#define MOTOR_PWM_MAX_DUTY 255
+#endif
+
 // ============================================================
 // TIMING CONSTANTS
 // ============================================================
@@ -73,14 +91,54 @@
 #define LONG_PRESS_MS 1000
 #define DOUBLE_CLICK_MS 400
 #define CONNECTION_TIMEOUT_MS 500
-#define DISPLAY_UPDATE_MS 100
+#define DISPLAY_UPDATE_MS 30 // ~33 fps cap; keeps the 5 ms scheduler base
+
+// Telemetry page: refresh cap, and the most OLED bus time it may take
+#define TELEMETRY_MIN_PERIOD_MS 50 // 20 Hz
+#define TELEMETRY_BUS_SHARE_PCT 25
+#define TELEMETRY_WINDOW_MS 1000 // Packet rate / loss averaging window
+
+// Framebuffer mirror on the serial console (master/tools/oled_mirror.py)
+#ifndef DISPLAY_MIRROR
+#define DISPLAY_MIRROR 0
+#endif
+#define DISPLAY_MIRROR_KEYFRAME_MS 2000 // Full image for late viewers
+
+// Radio link statistics (comm/link_stats.c)
+#define LINK_MAX_PEERS 4 // Senders tracked (remote, voice module)
+#define LINK_RSSI_WEAK_DBM (-80) // Status bar warns below this average
+
+// Telemetry back to the controller (comm/telemetry_tx.c), 0 = off
+#define TELEMETRY_TX_PERIOD_MS 100 // 10 Hz
+#define ESPNOW_TX_RING_LEN 4       // Messages queued for sending
+#define ESPNOW_TX_MAX_LEN 64       // Largest queued message
+
+// ============================================================
+// RATE GROUPS (executive)
+// ============================================================
+#define BUTTON_POLL_MS 10    // 100 Hz
+#define CONTROL_PERIOD_MS 5  // 200 Hz
+#define SCHED_TASK_STACK 4096
+#define SCHED_TASK_PRIO 5
+#define SCHED_STATS_LOG_MS 10000
+#define EVENT_QUEUE_LEN 32
+
+// Input-triggered control: run the control group as soon as a packet
+// arrives instead of waiting for the next period. The periodic release
+// slows to a fallback tick that only serves timeouts.
+#ifndef CONTROL_INPUT_TRIGGERED
+#define CONTROL_INPUT_TRIGGERED 0
+#endif
+#define CONTROL_MIN_GAP_US 1000
+#define CONTROL_FALLBACK_MS 20
 
 // ============================================================
 // CONTROL PARAMETERS
 // ============================================================
 #define DEADZONE 25
-#define DIAGONAL_RATIO 0.6f
 #define MAX_SPEED 255
+#define CONTROL_RAMP_MAX_DT_US 50000 // Longest step fed to the wheel ramp
+#define SHAPE_EXPO_Q8 64 // Expo share of the stick curve (0 = linear, 256 = cubic)
 
 // ============================================================
 // VOICE COMMAND DEFINITIONS
@@ -107,10 +165,22 @@
 #define NVS_KEY_MOTOR_CAL_FR "cal_fr"
 #define NVS_KEY_MOTOR_CAL_BL "cal_bl"
 #define NVS_KEY_MOTOR_CAL_BR "cal_br"
+#define NVS_KEY_RAMP_ACCEL_FL "ramp_a_fl"
+#define NVS_KEY_RAMP_ACCEL_FR "ramp_a_fr"
+#define NVS_KEY_RAMP_ACCEL_BL "ramp_a_bl"
+#define NVS_KEY_RAMP_ACCEL_BR "ramp_a_br"
+#define NVS_KEY_RAMP_DECEL_FL "ramp_d_fl"
+#define NVS_KEY_RAMP_DECEL_FR "ramp_d_fr"
+#define NVS_KEY_RAMP_DECEL_BL "ramp_d_bl"
+#define NVS_KEY_RAMP_DECEL_BR "ramp_d_br"
+#define NVS_KEY_RAMP_JERK "ramp_jerk"
 
 // Default values
 #define DEFAULT_BRIGHTNESS 255
 #define DEFAULT_VOLUME 80
 #define DEFAULT_MOTOR_CAL 255
+#define DEFAULT_RAMP_ACCEL 1000 // duty/s: 0 -> full in ~255 ms
+#define DEFAULT_RAMP_DECEL 2000 // duty/s: braking is allowed to be quicker
+#define DEFAULT_RAMP_JERK 0     // duty/s^2, 0 = trapezoidal ramp
 
 #endif // CONFIG_H
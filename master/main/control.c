@@ -0,0 +1,156 @@
+/**
+ * @file control.c
+ * @brief Control cycle: events -> mode -> motor outputs
+ */
+
+#include "hal_log.h"
+
+#include "config.h"
+#include "control.h"
+#include "display.h"
+#include "espnow_handler.h"
+#include "event_bus.h"
+#include "fsm.h"
+#include "hal_clock.h"
+#include "motor.h"
+#include "motor_ramp.h"
+#include "scheduler.h"
+#include "types.h"
+
+static const char *TAG = "CONTROL";
+
+static int s_group = -1;
+
+// Radio -> PWM latency of joystick frames
+static latency_hist_t s_latency;
+static uint32_t s_measured_frame = 0;
+
+// Time of the previous ramp step (0 = ramp idle)
+static int64_t s_last_output_us = 0;
+
+// ============================================================
+// INPUT TRIGGER (WiFi task)
+// ============================================================
+#if CONTROL_INPUT_TRIGGERED
+static void on_input(void) { scheduler_trigger(s_group); }
+#endif
+
+// ============================================================
+// LATENCY
+// ============================================================
+static void record_latency(void) {
+  if (g_ctx.joystick_frames == s_measured_frame) {
+    return;
+  }
+  s_measured_frame = g_ctx.joystick_frames;
+  latency_hist_record(&s_latency,
+                      (uint32_t)(hal_time_us() - g_ctx.joystick_rx_us));
+}
+
+// ============================================================
+// OUTPUT STAGE
+// ============================================================
+// Ramp the mode's wheel speeds; emergency stops bypass the ramp
+static void apply_outputs(void) {
+  if (g_ctx.movement == MOVEMENT_EMERGENCY) {
+    motor_stop_all();
+    s_last_output_us = 0;
+    return;
+  }
+
+  int64_t now = hal_time_us();
+  int64_t dt = s_last_output_us ? now - s_last_output_us : 0;
+  s_last_output_us = now;
+  if (dt > CONTROL_RAMP_MAX_DT_US) {
+    dt = CONTROL_RAMP_MAX_DT_US;
+  }
+
+  motor_speeds_t out;
+  motor_ramp_step(&g_ctx.motor_speeds, &out, (uint32_t)dt);
+  motor_apply_speeds(&out);
+}
+
+// ============================================================
+// DISPLAY HANDOFF
+// ============================================================
+// g_ctx.display_dirty is only touched on this task; the display task gets
+// a request flag instead
+static void forward_redraw(void) {
+  if (g_ctx.display_dirty) {
+    g_ctx.display_dirty = false;
+    display_request_redraw();
+  }
+}
+
+// ============================================================
+// CONTROL CYCLE
+// ============================================================
+void control_step(void) {
+  int64_t start = hal_time_us();
+
+  // Timeout tick, then apply every pending event
+  event_bus_post(EVT_TIMEOUT);
+  event_bus_dispatch_pending();
+
+  // Process control based on current state
+  switch (g_ctx.current_state) {
+  case STATE_MODE_MECANUM:
+  case STATE_MODE_RC:
+    if (g_ctx.joystick_connected) {
+      fsm_process_joystick();
+      apply_outputs();
+      record_latency();
+    }
+    break;
+  case STATE_MODE_VOICE:
+    if (g_ctx.voice_connected) {
+      fsm_process_voice();
+      apply_outputs();
+    }
+    break;
+  default:
+    s_last_output_us = 0;
+    break;
+  }
+
+  forward_redraw();
+  g_ctx.control_loop_us = (uint32_t)(hal_time_us() - start);
+}
+
+// ============================================================
+// INITIALIZATION
+// ============================================================
+void control_init(void) {
+  latency_hist_reset(&s_latency);
+  s_measured_frame = 0;
+  s_last_output_us = 0;
+  motor_ramp_configure(&g_ctx.settings);
+
+#if CONTROL_INPUT_TRIGGERED
+  s_group = scheduler_add_group("control", CONTROL_FALLBACK_MS * 1000,
+                                control_step);
+  scheduler_enable_trigger(s_group, CONTROL_MIN_GAP_US);
+  espnow_handler_set_rx_hook(on_input);
+  ESP_LOGI(TAG, "Input-triggered control, fallback %d ms",
+           CONTROL_FALLBACK_MS);
+#else
+  s_group = scheduler_add_group("control", CONTROL_PERIOD_MS * 1000,
+                                control_step);
+  ESP_LOGI(TAG, "Periodic control, %d ms", CONTROL_PERIOD_MS);
+#endif
+}
+
+// ============================================================
+// STATISTICS
+// ============================================================
+const latency_hist_t *control_get_latency(void) { return &s_latency; }
+
+void control_log_stats(void) {
+  ESP_LOGI(TAG,
+           "Radio->PWM: n=%lu p50=%lu p90=%lu p99=%lu max=%lu us",
+           (unsigned long)s_latency.count,
+           (unsigned long)latency_hist_percentile(&s_latency, 50),
+           (unsigned long)latency_hist_percentile(&s_latency, 90),
+           (unsigned long)latency_hist_percentile(&s_latency, 99),
+           (unsigned long)s_latency.max_us);
+}
@@ -0,0 +1,37 @@
+/**
+ * @file control.h
+ * @brief Control cycle: events -> mode -> motor outputs
+ */
+
+#ifndef CONTROL_H
+#define CONTROL_H
+
+#include <stdint.h>
+
+#include "latency_hist.h"
+
+/**
+ * @brief Register the control rate group with the executive
+ *
+ * Periodic at CONTROL_PERIOD_MS, or, with CONTROL_INPUT_TRIGGERED, run on
+ * every input packet with a CONTROL_FALLBACK_MS periodic tick.
+ */
+void control_init(void);
+
+/**
+ * @brief Run one control cycle (executive task only)
+ */
+void control_step(void);
+
+/**
+ * @brief Get the radio-arrival to PWM-write latency histogram
+ * @return Histogram (owned by the control task, read-only)
+ */
+const latency_hist_t *control_get_latency(void);
+
+/**
+ * @brief Log latency percentiles
+ */
+void control_log_stats(void);
+
+#endif // CONTROL_H
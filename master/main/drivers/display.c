@@ -3,13 +3,17 @@
  * @brief OLED SSD1306 display driver implementation
  */
 
-#include "driver/i2c.h"
-#include "esp_log.h"
+#include <stdatomic.h>
+#include <stdio.h>
 #include <string.h>
 
-
 #include "config.h"
 #include "display.h"
+#include "display_mirror.h"
+#include "font.h"
+#include "hal_clock.h"
+#include "hal_i2c.h"
+#include "hal_log.h"
 #include "mode_mecanum.h"
 #include "mode_menu.h"
 #include "mode_rc.h"
@@ -25,34 +29,79 @@ static const char *TAG = "DISPLAY";
 #define SSD1306_CMD_DISPLAY_OFF 0xAE
 #define SSD1306_CMD_DISPLAY_ON 0xAF
 #define SSD1306_CMD_SET_CONTRAST 0x81
-#define SSD1306_CMD_SET_PAGE 0xB0
-#define SSD1306_CMD_SET_COL_LOW 0x00
-#define SSD1306_CMD_SET_COL_HIGH 0x10
+#define SSD1306_CMD_COL_ADDR 0x21  // + first, last column
+#define SSD1306_CMD_PAGE_ADDR 0x22 // + first, last page
+
+#define OLED_PAGES (OLED_HEIGHT / 8)
 
-// Display buffer
+// Back buffer: modes render here (owner task only)
 static uint8_t s_framebuffer[OLED_WIDTH * OLED_HEIGHT / 8];
+static bool s_back_ready = false; // Holds a frame not yet sent
+
+// Copy of what the panel shows (invalid until the first full flush)
+static uint8_t s_shadow[OLED_WIDTH * OLED_HEIGHT / 8];
+static bool s_shadow_valid = false;
+
+static display_flush_stats_t s_flush_stats;
+
+// Drawing work of the render in progress, and of the latest one
+static display_render_stats_t s_render_stats;
+static uint32_t s_pixel_calls = 0;
+static uint32_t s_blit_cols = 0;
+static uint32_t s_fill_bytes = 0;
+
+// Requests from other tasks, applied by the owner task
+static atomic_int s_brightness_req = -1;
+static atomic_bool s_redraw_req = false;
+static display_wake_fn_t s_wake_hook = NULL;
 
 // ============================================================
 // I2C COMMUNICATION
 // ============================================================
-static esp_err_t i2c_write_cmd(uint8_t cmd) {
-  uint8_t data[2] = {0x00, cmd}; // Co=0, D/C#=0 (command)
-  return i2c_master_write_to_device(OLED_I2C_NUM, OLED_ADDRESS, data,
-                                    sizeof(data), pdMS_TO_TICKS(100));
-}
+// SSD1306 control bytes
+#define SSD1306_CTRL_CMDS 0x00 // Co=0, D/C#=0: command stream
+#define SSD1306_CTRL_CMD 0x80  // Co=1, D/C#=0: one command, more follow
+#define SSD1306_CTRL_DATA 0x40 // Co=0, D/C#=1: data stream
+
+// Front buffer: window commands (6 x 2 bytes) + data control byte + up to
+// one full frame. Owned by the bus while s_tx_busy is set.
+#define DISPLAY_TX_HEADER 13
+static uint8_t s_tx[DISPLAY_TX_HEADER + sizeof(s_framebuffer)];
+static atomic_bool s_tx_busy = false;
+static int64_t s_tx_start_us = 0;
 
-static esp_err_t i2c_write_data(const uint8_t *data, size_t len) {
-  uint8_t *buf = malloc(len + 1);
-  if (!buf)
-    return ESP_ERR_NO_MEM;
+// Completion of a front buffer transfer (interrupt context on target)
+static bool on_tx_done(bool ok, void *ctx) {
+  (void)ctx;
+  uint32_t elapsed = (uint32_t)(hal_time_us() - s_tx_start_us);
+  s_flush_stats.last_us = elapsed;
+  if (elapsed > s_flush_stats.max_us)
+    s_flush_stats.max_us = elapsed;
 
-  buf[0] = 0x40; // Co=0, D/C#=1 (data)
-  memcpy(buf + 1, data, len);
+  // A failed write leaves the panel unknown: resend everything next time
+  if (!ok)
+    s_shadow_valid = false;
 
-  esp_err_t ret = i2c_master_write_to_device(OLED_I2C_NUM, OLED_ADDRESS, buf,
-                                             len + 1, pdMS_TO_TICKS(100));
-  free(buf);
-  return ret;
+  atomic_store(&s_tx_busy, false);
+  return s_wake_hook ? s_wake_hook() : false;
+}
+
+static bool tx_start(size_t len) {
+  atomic_store(&s_tx_busy, true);
+  s_tx_start_us = hal_time_us();
+  if (!hal_i2c_write_async(OLED_ADDRESS, s_tx, len, on_tx_done, NULL)) {
+    s_shadow_valid = false;
+    atomic_store(&s_tx_busy, false);
+    return false;
+  }
+  return true;
+}
+
+// Send a command sequence in one transaction and wait (init only)
+static bool i2c_write_cmds(const uint8_t *cmds, size_t len) {
+  s_tx[0] = SSD1306_CTRL_CMDS;
+  memcpy(&s_tx[1], cmds, len);
+  return hal_i2c_write(OLED_ADDRESS, s_tx, len + 1);
 }
 
 // ============================================================
@@ -60,16 +109,10 @@ static esp_err_t i2c_write_data(const uint8_t *data, size_t len) {
 // ============================================================
 void display_init(void) {
   // Configure I2C
-  i2c_config_t conf = {
-      .mode = I2C_MODE_MASTER,
-      .sda_io_num = PIN_OLED_SDA,
-      .scl_io_num = PIN_OLED_SCL,
-      .sda_pullup_en = GPIO_PULLUP_ENABLE,
-      .scl_pullup_en = GPIO_PULLUP_ENABLE,
-      .master.clk_speed = OLED_I2C_FREQ,
-  };
-  ESP_ERROR_CHECK(i2c_param_config(OLED_I2C_NUM, &conf));
-  ESP_ERROR_CHECK(i2c_driver_install(OLED_I2C_NUM, I2C_MODE_MASTER, 0, 0, 0));
+  if (!hal_i2c_init(PIN_OLED_SDA, PIN_OLED_SCL, OLED_I2C_FREQ)) {
+    ESP_LOGE(TAG, "I2C init failed");
+    return;
+  }
 
   // SSD1306 initialization sequence
   const uint8_t init_cmds[] = {
@@ -91,9 +134,7 @@ void display_init(void) {
       0xAF,       // Display on
   };
 
-  for (int i = 0; i < sizeof(init_cmds); i++) {
-    i2c_write_cmd(init_cmds[i]);
-  }
+  i2c_write_cmds(init_cmds, sizeof(init_cmds));
 
   // Clear framebuffer
   memset(s_framebuffer, 0, sizeof(s_framebuffer));
@@ -106,43 +147,167 @@ void display_init(void) {
 // ============================================================
 void display_clear(void) { memset(s_framebuffer, 0, sizeof(s_framebuffer)); }
 
+// Pack the window spanning every changed column span of the back buffer
+// into the front buffer and start sending it in one transaction, through
+// the column/page address window (horizontal addressing)
 static void display_flush(void) {
-  for (int page = 0; page < 8; page++) {
-    i2c_write_cmd(SSD1306_CMD_SET_PAGE | page);
-    i2c_write_cmd(SSD1306_CMD_SET_COL_LOW | 0);
-    i2c_write_cmd(SSD1306_CMD_SET_COL_HIGH | 0);
-    i2c_write_data(&s_framebuffer[page * OLED_WIDTH], OLED_WIDTH);
+  int first_page = OLED_PAGES, last_page = -1;
+  int first_col = OLED_WIDTH, last_col = -1;
+
+  for (int page = 0; page < OLED_PAGES; page++) {
+    const uint8_t *fb = &s_framebuffer[page * OLED_WIDTH];
+    const uint8_t *shadow = &s_shadow[page * OLED_WIDTH];
+    int first = 0;
+    int last = OLED_WIDTH - 1;
+
+    if (s_shadow_valid) {
+      while (first < OLED_WIDTH && fb[first] == shadow[first])
+        first++;
+      if (first == OLED_WIDTH)
+        continue;
+      while (fb[last] == shadow[last])
+        last--;
+    }
+
+    if (first_page == OLED_PAGES)
+      first_page = page;
+    last_page = page;
+    if (first < first_col)
+      first_col = first;
+    if (last > last_col)
+      last_col = last;
   }
+
+  uint32_t bytes = 0;
+  if (last_page >= 0) {
+    uint8_t *p = s_tx;
+    *p++ = SSD1306_CTRL_CMD;
+    *p++ = SSD1306_CMD_COL_ADDR;
+    *p++ = SSD1306_CTRL_CMD;
+    *p++ = (uint8_t)first_col;
+    *p++ = SSD1306_CTRL_CMD;
+    *p++ = (uint8_t)last_col;
+    *p++ = SSD1306_CTRL_CMD;
+    *p++ = SSD1306_CMD_PAGE_ADDR;
+    *p++ = SSD1306_CTRL_CMD;
+    *p++ = (uint8_t)first_page;
+    *p++ = SSD1306_CTRL_CMD;
+    *p++ = (uint8_t)last_page;
+    *p++ = SSD1306_CTRL_DATA;
+
+#if DISPLAY_MIRROR
+    // Before the shadow catches up: it still holds the previous frame
+    display_mirror_send(s_framebuffer, s_shadow_valid ? s_shadow : NULL,
+                        first_page, last_page);
+#endif
+
+    int width = last_col - first_col + 1;
+    for (int page = first_page; page <= last_page; page++) {
+      int offset = page * OLED_WIDTH + first_col;
+      memcpy(p, &s_framebuffer[offset], width);
+      memcpy(&s_shadow[offset], &s_framebuffer[offset], width);
+      p += width;
+    }
+
+    bytes = (uint32_t)(p - s_tx);
+    s_shadow_valid = true;
+    tx_start(bytes);
+  }
+
+  s_flush_stats.frames++;
+  s_flush_stats.last_bytes = bytes;
+  s_flush_stats.total_bytes += bytes;
+  if (bytes > s_flush_stats.max_bytes)
+    s_flush_stats.max_bytes = bytes;
 }
 
 // Drawing functions
 void display_set_pixel(int x, int y, bool on) {
+  s_pixel_calls++;
   if (x < 0 || x >= OLED_WIDTH || y < 0 || y >= OLED_HEIGHT)
     return;
 
-  int idx = x + (y / 8) * OLED_WIDTH;
+  int idx = x + (y >> 3) * OLED_WIDTH;
   if (on) {
-    s_framebuffer[idx] |= (1 << (y % 8));
+    s_framebuffer[idx] |= (uint8_t)(1 << (y & 7));
   } else {
-    s_framebuffer[idx] &= ~(1 << (y % 8));
+    s_framebuffer[idx] &= (uint8_t)~(1 << (y & 7));
   }
 }
 
-void display_draw_char(int x, int y, char c) {
-  // Simple 5x7 font rendering - using basic font
-  extern const uint8_t font5x7[];
-  if (c < 32 || c > 126)
-    c = ' ';
-
-  const uint8_t *glyph = &font5x7[(c - 32) * 5];
-  for (int col = 0; col < 5; col++) {
-    uint8_t line = glyph[col];
-    for (int row = 0; row < 7; row++) {
-      display_set_pixel(x + col, y + row, (line >> row) & 1);
+// Combine column bytes (LSB = top row, h <= 8 rows) into the page-organised
+// framebuffer; a column straddling two pages is split with one shift.
+void display_blit_columns(int x, int y, const uint8_t *cols, int w, int h,
+                          draw_mode_t mode) {
+  if (h <= 0 || y >= OLED_HEIGHT || y + h <= 0)
+    return;
+
+  int page = y >> 3; // Floor, also for negative y
+  int shift = y & 7;
+  uint8_t keep = (uint8_t)((1U << h) - 1);
+
+  int c0 = (x < 0) ? -x : 0;
+  int c1 = (x + w > OLED_WIDTH) ? OLED_WIDTH - x : w;
+  if (c1 > c0)
+    s_blit_cols += c1 - c0;
+
+  for (int c = c0; c < c1; c++) {
+    uint16_t v = (uint16_t)((cols[c] & keep) << shift);
+    uint8_t lo = (uint8_t)v;
+    uint8_t hi = (uint8_t)(v >> 8);
+
+    if (page >= 0 && lo) {
+      uint8_t *dst = &s_framebuffer[page * OLED_WIDTH + x + c];
+      switch (mode) {
+      case DRAW_SET:
+        *dst |= lo;
+        break;
+      case DRAW_CLEAR:
+        *dst &= (uint8_t)~lo;
+        break;
+      case DRAW_XOR:
+        *dst ^= lo;
+        break;
+      }
+    }
+    if (page + 1 < OLED_PAGES && hi) {
+      uint8_t *dst = &s_framebuffer[(page + 1) * OLED_WIDTH + x + c];
+      switch (mode) {
+      case DRAW_SET:
+        *dst |= hi;
+        break;
+      case DRAW_CLEAR:
+        *dst &= (uint8_t)~hi;
+        break;
+      case DRAW_XOR:
+        *dst ^= hi;
+        break;
+      }
     }
   }
 }
 
+// Glyph index, with unknown characters drawn as a space
+static int glyph_index(const font_t *font, char c) {
+  int i = font_index(font, c);
+  return (i >= 0) ? i : font_index(font, ' ');
+}
+
+static const uint8_t *glyph_5x7(char c) {
+  return &font_5x7.bitmap[font_5x7.offset[glyph_index(&font_5x7, c)]];
+}
+
+void display_draw_char_mode(int x, int y, char c, draw_mode_t mode) {
+  display_blit_columns(x, y, glyph_5x7(c), 5, 7, mode);
+}
+
+void display_draw_char(int x, int y, char c) {
+  // Opaque 5x7 cell: clear the background, then set the glyph
+  static const uint8_t cell[5] = {0x7F, 0x7F, 0x7F, 0x7F, 0x7F};
+  display_blit_columns(x, y, cell, 5, 7, DRAW_CLEAR);
+  display_blit_columns(x, y, glyph_5x7(c), 5, 7, DRAW_SET);
+}
+
 void display_draw_string(int x, int y, const char *str) {
   while (*str) {
     display_draw_char(x, y, *str++);
@@ -150,48 +315,192 @@ void display_draw_string(int x, int y, const char *str) {
   }
 }
 
-void display_fill_rect(int x, int y, int w, int h, bool on) {
-  for (int i = x; i < x + w; i++) {
-    for (int j = y; j < y + h; j++) {
-      display_set_pixel(i, j, on);
+void display_draw_string_mode(int x, int y, const char *str,
+                              draw_mode_t mode) {
+  while (*str) {
+    display_draw_char_mode(x, y, *str++, mode);
+    x += 6;
+  }
+}
+
+int display_draw_text(int x, int y, const char *str, const font_t *font,
+                      draw_mode_t mode) {
+  for (; *str; str++) {
+    int i = glyph_index(font, *str);
+    if (i < 0)
+      continue;
+    display_blit(x, y, &font->bitmap[font->offset[i]], font->width[i],
+                 font->height, mode);
+    x += font->width[i] + font->spacing;
+  }
+  return x;
+}
+
+int display_text_width(const char *str, const font_t *font) {
+  int w = 0;
+  for (; *str; str++) {
+    int i = glyph_index(font, *str);
+    if (i >= 0)
+      w += font->width[i] + font->spacing;
+  }
+  // No spacing after the last glyph
+  return (w > 0) ? w - font->spacing : 0;
+}
+
+// Page-organised bitmap: ceil(h / 8) bands of w column bytes
+void display_blit(int x, int y, const uint8_t *bitmap, int w, int h,
+                  draw_mode_t mode) {
+  for (int band = 0; band * 8 < h; band++) {
+    int rows = (h - band * 8 < 8) ? h - band * 8 : 8;
+    display_blit_columns(x, y + band * 8, &bitmap[band * w], w, rows, mode);
+  }
+}
+
+// Apply one row mask to a run of columns of one page
+static void apply_run(uint8_t *dst, int n, uint8_t mask, draw_mode_t mode) {
+  s_fill_bytes += n;
+  if (mask == 0xFF && mode != DRAW_XOR) {
+    memset(dst, (mode == DRAW_SET) ? 0xFF : 0x00, n);
+    return;
+  }
+  for (int i = 0; i < n; i++) {
+    switch (mode) {
+    case DRAW_SET:
+      dst[i] |= mask;
+      break;
+    case DRAW_CLEAR:
+      dst[i] &= (uint8_t)~mask;
+      break;
+    case DRAW_XOR:
+      dst[i] ^= mask;
+      break;
     }
   }
 }
 
-void display_draw_rect(int x, int y, int w, int h) {
-  for (int i = x; i < x + w; i++) {
-    display_set_pixel(i, y, true);
-    display_set_pixel(i, y + h - 1, true);
+void display_fill_rect_mode(int x, int y, int w, int h, draw_mode_t mode) {
+  // Clip to the screen
+  if (x < 0) {
+    w += x;
+    x = 0;
+  }
+  if (y < 0) {
+    h += y;
+    y = 0;
+  }
+  if (x + w > OLED_WIDTH)
+    w = OLED_WIDTH - x;
+  if (y + h > OLED_HEIGHT)
+    h = OLED_HEIGHT - y;
+  if (w <= 0 || h <= 0)
+    return;
+
+  // Top and bottom pages take partial masks, the ones between are full
+  int y1 = y + h - 1;
+  for (int page = y >> 3; page <= (y1 >> 3); page++) {
+    uint8_t mask = 0xFF;
+    if (page == (y >> 3))
+      mask &= (uint8_t)(0xFF << (y & 7));
+    if (page == (y1 >> 3))
+      mask &= (uint8_t)(0xFF >> (7 - (y1 & 7)));
+    apply_run(&s_framebuffer[page * OLED_WIDTH + x], w, mask, mode);
   }
-  for (int j = y; j < y + h; j++) {
-    display_set_pixel(x, j, true);
-    display_set_pixel(x + w - 1, j, true);
+}
+
+void display_fill_rect(int x, int y, int w, int h, bool on) {
+  display_fill_rect_mode(x, y, w, h, on ? DRAW_SET : DRAW_CLEAR);
+}
+
+void display_draw_hline(int x, int y, int w, bool on) {
+  display_fill_rect(x, y, w, 1, on);
+}
+
+void display_draw_vline(int x, int y, int h, bool on) {
+  display_fill_rect(x, y, 1, h, on);
+}
+
+void display_draw_rect(int x, int y, int w, int h) {
+  if (w <= 0 || h <= 0)
+    return;
+  display_draw_hline(x, y, w, true);
+  display_draw_hline(x, y + h - 1, w, true);
+  display_draw_vline(x, y, h, true);
+  display_draw_vline(x + w - 1, y, h, true);
+}
+
+// Bresenham, all octants
+void display_draw_line(int x0, int y0, int x1, int y1, bool on) {
+  int dx = (x1 > x0) ? x1 - x0 : x0 - x1;
+  int dy = (y1 > y0) ? y0 - y1 : y1 - y0; // Negative
+  int sx = (x0 < x1) ? 1 : -1;
+  int sy = (y0 < y1) ? 1 : -1;
+  int err = dx + dy;
+
+  while (1) {
+    display_set_pixel(x0, y0, on);
+    if (x0 == x1 && y0 == y1)
+      break;
+    int e2 = 2 * err;
+    if (e2 >= dy) {
+      err += dy;
+      x0 += sx;
+    }
+    if (e2 <= dx) {
+      err += dx;
+      y0 += sy;
+    }
   }
 }
 
+// ============================================================
+// RENDER COST
+// ============================================================
+static int64_t cost_begin(void) {
+  s_pixel_calls = 0;
+  s_blit_cols = 0;
+  s_fill_bytes = 0;
+  return hal_time_us();
+}
+
+static void cost_end(int64_t start_us) {
+  uint32_t elapsed = (uint32_t)(hal_time_us() - start_us);
+
+  s_render_stats.renders++;
+  s_render_stats.pixel_calls = s_pixel_calls;
+  s_render_stats.blit_cols = s_blit_cols;
+  s_render_stats.fill_bytes = s_fill_bytes;
+  s_render_stats.last_us = elapsed;
+  if (elapsed > s_render_stats.max_us)
+    s_render_stats.max_us = elapsed;
+}
+
 // ============================================================
 // SPLASH SCREEN
 // ============================================================
 void display_splash(void) {
+  int64_t start = cost_begin();
   display_clear();
   display_draw_string(20, 20, "MINI OS v1");
   display_draw_string(25, 35, "ESP32-S3");
   display_draw_string(15, 50, "Mecanum Robot");
-  display_flush();
+  cost_end(start);
+  s_back_ready = true;
+  display_service();
 }
 
 // ============================================================
 // SET BRIGHTNESS
 // ============================================================
 void display_set_brightness(uint8_t brightness) {
-  i2c_write_cmd(SSD1306_CMD_SET_CONTRAST);
-  i2c_write_cmd(brightness);
+  atomic_store(&s_brightness_req, brightness);
 }
 
+void display_request_redraw(void) { atomic_store(&s_redraw_req, true); }
+
 // ============================================================
-// UPDATE DISPLAY
+// OWNER TASK STEP
 // ============================================================
-void display_update(void) {
+static void render(void) {
   display_clear();
 
   switch (g_ctx.current_state) {
@@ -211,107 +520,95 @@ void display_update(void) {
     mode_settings_draw();
     break;
   }
+}
 
-  display_flush();
+// Redraw just the changed widgets of a screen that has them
+static bool refresh(void) {
+  switch (g_ctx.current_state) {
+  case STATE_MODE_MECANUM:
+    return mode_mecanum_refresh();
+  case STATE_MODE_RC:
+    return mode_rc_refresh();
+  default:
+    return false;
+  }
+}
+
+void display_service(void) {
+  // Render the next frame while the previous one is still on the bus;
+  // take the request first so one made meanwhile triggers another frame.
+  // Without a full redraw pending, live widgets update in place.
+  if (!s_back_ready) {
+    int64_t start = cost_begin();
+    if (atomic_exchange(&s_redraw_req, false)) {
+      render();
+      s_back_ready = true;
+    } else {
+      s_back_ready = refresh();
+    }
+    if (s_back_ready)
+      cost_end(start);
+  }
+
+  if (atomic_load(&s_tx_busy)) {
+    return; // The completion wakes us again
+  }
+
+  int level = atomic_exchange(&s_brightness_req, -1);
+  if (level >= 0) {
+    s_tx[0] = SSD1306_CTRL_CMDS;
+    s_tx[1] = SSD1306_CMD_SET_CONTRAST;
+    s_tx[2] = (uint8_t)level;
+    tx_start(3);
+    return;
+  }
+
+  if (s_back_ready) {
+    s_back_ready = false;
+    display_flush();
+    return;
+  }
+
+#if DISPLAY_MIRROR
+  if (s_shadow_valid)
+    display_mirror_poll(s_shadow, hal_time_us());
+#endif
+}
+
+void display_set_wake_hook(display_wake_fn_t hook) { s_wake_hook = hook; }
+
+// ============================================================
+// STATISTICS
+// ============================================================
+void display_get_flush_stats(display_flush_stats_t *out) {
+  *out = s_flush_stats;
+}
+
+void display_get_render_stats(display_render_stats_t *out) {
+  *out = s_render_stats;
 }
 
 // ============================================================
-// 5x7 FONT DATA
+// FRAME EXPORT
 // ============================================================
-const uint8_t font5x7[] = {
-    0x00, 0x00, 0x00, 0x00, 0x00, // Space
-    0x00, 0x00, 0x5F, 0x00, 0x00, // !
-    0x00, 0x07, 0x00, 0x07, 0x00, // "
-    0x14, 0x7F, 0x14, 0x7F, 0x14, // #
-    0x24, 0x2A, 0x7F, 0x2A, 0x12, // $
-    0x23, 0x13, 0x08, 0x64, 0x62, // %
-    0x36, 0x49, 0x55, 0x22, 0x50, // &
-    0x00, 0x05, 0x03, 0x00, 0x00, // '
-    0x00, 0x1C, 0x22, 0x41, 0x00, // (
-    0x00, 0x41, 0x22, 0x1C, 0x00, // )
-    0x08, 0x2A, 0x1C, 0x2A, 0x08, // *
-    0x08, 0x08, 0x3E, 0x08, 0x08, // +
-    0x00, 0x50, 0x30, 0x00, 0x00, // ,
-    0x08, 0x08, 0x08, 0x08, 0x08, // -
-    0x00, 0x60, 0x60, 0x00, 0x00, // .
-    0x20, 0x10, 0x08, 0x04, 0x02, // /
-    0x3E, 0x51, 0x49, 0x45, 0x3E, // 0
-    0x00, 0x42, 0x7F, 0x40, 0x00, // 1
-    0x42, 0x61, 0x51, 0x49, 0x46, // 2
-    0x21, 0x41, 0x45, 0x4B, 0x31, // 3
-    0x18, 0x14, 0x12, 0x7F, 0x10, // 4
-    0x27, 0x45, 0x45, 0x45, 0x39, // 5
-    0x3C, 0x4A, 0x49, 0x49, 0x30, // 6
-    0x01, 0x71, 0x09, 0x05, 0x03, // 7
-    0x36, 0x49, 0x49, 0x49, 0x36, // 8
-    0x06, 0x49, 0x49, 0x29, 0x1E, // 9
-    0x00, 0x36, 0x36, 0x00, 0x00, // :
-    0x00, 0x56, 0x36, 0x00, 0x00, // ;
-    0x00, 0x08, 0x14, 0x22, 0x41, // <
-    0x14, 0x14, 0x14, 0x14, 0x14, // =
-    0x41, 0x22, 0x14, 0x08, 0x00, // >
-    0x02, 0x01, 0x51, 0x09, 0x06, // ?
-    0x32, 0x49, 0x79, 0x41, 0x3E, // @
-    0x7E, 0x11, 0x11, 0x11, 0x7E, // A
-    0x7F, 0x49, 0x49, 0x49, 0x36, // B
-    0x3E, 0x41, 0x41, 0x41, 0x22, // C
-    0x7F, 0x41, 0x41, 0x22, 0x1C, // D
-    0x7F, 0x49, 0x49, 0x49, 0x41, // E
-    0x7F, 0x09, 0x09, 0x01, 0x01, // F
-    0x3E, 0x41, 0x41, 0x51, 0x32, // G
-    0x7F, 0x08, 0x08, 0x08, 0x7F, // H
-    0x00, 0x41, 0x7F, 0x41, 0x00, // I
-    0x20, 0x40, 0x41, 0x3F, 0x01, // J
-    0x7F, 0x08, 0x14, 0x22, 0x41, // K
-    0x7F, 0x40, 0x40, 0x40, 0x40, // L
-    0x7F, 0x02, 0x04, 0x02, 0x7F, // M
-    0x7F, 0x04, 0x08, 0x10, 0x7F, // N
-    0x3E, 0x41, 0x41, 0x41, 0x3E, // O
-    0x7F, 0x09, 0x09, 0x09, 0x06, // P
-    0x3E, 0x41, 0x51, 0x21, 0x5E, // Q
-    0x7F, 0x09, 0x19, 0x29, 0x46, // R
-    0x46, 0x49, 0x49, 0x49, 0x31, // S
-    0x01, 0x01, 0x7F, 0x01, 0x01, // T
-    0x3F, 0x40, 0x40, 0x40, 0x3F, // U
-    0x1F, 0x20, 0x40, 0x20, 0x1F, // V
-    0x7F, 0x20, 0x18, 0x20, 0x7F, // W
-    0x63, 0x14, 0x08, 0x14, 0x63, // X
-    0x03, 0x04, 0x78, 0x04, 0x03, // Y
-    0x61, 0x51, 0x49, 0x45, 0x43, // Z
-    0x00, 0x00, 0x7F, 0x41, 0x41, // [
-    0x02, 0x04, 0x08, 0x10, 0x20, // backslash
-    0x41, 0x41, 0x7F, 0x00, 0x00, // ]
-    0x04, 0x02, 0x01, 0x02, 0x04, // ^
-    0x40, 0x40, 0x40, 0x40, 0x40, // _
-    0x00, 0x01, 0x02, 0x04, 0x00, // `
-    0x20, 0x54, 0x54, 0x54, 0x78, // a
-    0x7F, 0x48, 0x44, 0x44, 0x38, // b
-    0x38, 0x44, 0x44, 0x44, 0x20, // c
-    0x38, 0x44, 0x44, 0x48, 0x7F, // d
-    0x38, 0x54, 0x54, 0x54, 0x18, // e
-    0x08, 0x7E, 0x09, 0x01, 0x02, // f
-    0x08, 0x14, 0x54, 0x54, 0x3C, // g
-    0x7F, 0x08, 0x04, 0x04, 0x78, // h
-    0x00, 0x44, 0x7D, 0x40, 0x00, // i
-    0x20, 0x40, 0x44, 0x3D, 0x00, // j
-    0x00, 0x7F, 0x10, 0x28, 0x44, // k
-    0x00, 0x41, 0x7F, 0x40, 0x00, // l
-    0x7C, 0x04, 0x18, 0x04, 0x78, // m
-    0x7C, 0x08, 0x04, 0x04, 0x78, // n
-    0x38, 0x44, 0x44, 0x44, 0x38, // o
-    0x7C, 0x14, 0x14, 0x14, 0x08, // p
-    0x08, 0x14, 0x14, 0x18, 0x7C, // q
-    0x7C, 0x08, 0x04, 0x04, 0x08, // r
-    0x48, 0x54, 0x54, 0x54, 0x20, // s
-    0x04, 0x3F, 0x44, 0x40, 0x20, // t
-    0x3C, 0x40, 0x40, 0x20, 0x7C, // u
-    0x1C, 0x20, 0x40, 0x20, 0x1C, // v
-    0x3C, 0x40, 0x30, 0x40, 0x3C, // w
-    0x44, 0x28, 0x10, 0x28, 0x44, // x
-    0x0C, 0x50, 0x50, 0x50, 0x3C, // y
-    0x44, 0x64, 0x54, 0x4C, 0x44, // z
-    0x00, 0x08, 0x36, 0x41, 0x00, // {
-    0x00, 0x00, 0x7F, 0x00, 0x00, // |
-    0x00, 0x41, 0x36, 0x08, 0x00, // }
-    0x08, 0x08, 0x2A, 0x1C, 0x08, // ~
-};
+// Binary PBM (P4): rows of MSB-first bits, 1 = lit pixel
+size_t display_get_pbm(uint8_t *buf, size_t len) {
+  if (len < DISPLAY_PBM_MAX_BYTES)
+    return 0;
+
+  size_t n = (size_t)snprintf((char *)buf, len, "P4\n%d %d\n", OLED_WIDTH,
+                              OLED_HEIGHT);
+  for (int y = 0; y < OLED_HEIGHT; y++) {
+    const uint8_t *page = &s_framebuffer[(y >> 3) * OLED_WIDTH];
+    uint8_t bit = (uint8_t)(1 << (y & 7));
+    for (int x = 0; x < OLED_WIDTH; x += 8) {
+      uint8_t out = 0;
+      for (int i = 0; i < 8; i++) {
+        if (page[x + i] & bit)
+          out |= (uint8_t)(0x80 >> i);
+      }
+      buf[n++] = out;
+    }
+  }
+  return n;
+}
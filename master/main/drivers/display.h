@@ -1,30 +1,93 @@
 /**
  * @file display.h
  * @brief OLED SSD1306 display driver
+ *
+ * One owner task drives the bus through display_service(). Modes render
+ * into the back buffer while the previous frame drains from the front
+ * buffer asynchronously; the transfer completion wakes the owner through
+ * the wake hook. Other tasks only post requests (brightness).
  */
 
 #ifndef DISPLAY_H
 #define DISPLAY_H
 
+#include <stddef.h>
+#include <stdint.h>
+
+#include "config.h"
 #include "types.h"
 
+// Largest PBM image display_get_pbm() produces (header + 1 bit per pixel)
+#define DISPLAY_PBM_MAX_BYTES (16 + OLED_WIDTH * OLED_HEIGHT / 8)
+
+/**
+ * @brief I2C traffic of display flushes (bytes include command overhead)
+ */
+typedef struct {
+  uint32_t frames;      // Flushes performed
+  uint32_t last_bytes;  // Bytes sent by the latest flush
+  uint32_t max_bytes;   // Largest flush
+  uint64_t total_bytes; // Sum over all flushes
+  uint32_t last_us;     // Duration of the latest flush
+  uint32_t max_us;      // Longest flush
+} display_flush_stats_t;
+
+/**
+ * @brief Drawing work of renders (work counts are of the latest render)
+ *
+ * A render is a full redraw, a widget refresh that drew something, or the
+ * splash screen.
+ */
+typedef struct {
+  uint32_t renders;     // Renders performed
+  uint32_t pixel_calls; // display_set_pixel() calls
+  uint32_t blit_cols;   // Column bytes combined by glyph / bitmap blits
+  uint32_t fill_bytes;  // Framebuffer bytes touched by fills and lines
+  uint32_t last_us;     // Duration of the latest render
+  uint32_t max_us;      // Longest render
+} display_render_stats_t;
+
 /**
  * @brief Initialize OLED display
  */
 void display_init(void);
 
 /**
- * @brief Show splash screen
+ * @brief Wakes the owner task; may run in interrupt context
+ * @return true if a higher-priority task was woken
+ */
+typedef bool (*display_wake_fn_t)(void);
+
+/**
+ * @brief Show splash screen (before the owner task starts)
  */
 void display_splash(void);
 
 /**
- * @brief Update display based on current state
+ * @brief Owner task step: render if requested, then start the next transfer
+ *
+ * With no full redraw pending, screens built from widgets (ui_widgets.h)
+ * redraw only the widgets whose values changed. Call on every display
+ * tick and whenever the wake hook fires.
+ */
+void display_service(void);
+
+/**
+ * @brief Request a full redraw (any task, never blocks)
+ *
+ * g_ctx.display_dirty belongs to the dispatcher, which forwards it here;
+ * the owner task renders on its next step.
+ */
+void display_request_redraw(void);
+
+/**
+ * @brief Set the hook called when a transfer completes
+ * @param hook Wake function (NULL = none)
  */
-void display_update(void);
+void display_set_wake_hook(display_wake_fn_t hook);
 
 /**
- * @brief Set display brightness
+ * @brief Request a display brightness (applied by the owner task)
  * @param brightness 0-255
  */
 void display_set_brightness(uint8_t brightness);
@@ -34,4 +97,24 @@ void display_set_brightness(uint8_t brightness);
  */
 void display_clear(void);
 
+/**
+ * @brief Get flush traffic statistics
+ * @param out Destination
+ */
+void display_get_flush_stats(display_flush_stats_t *out);
+
+/**
+ * @brief Get render cost statistics
+ * @param out Destination
+ */
+void display_get_render_stats(display_render_stats_t *out);
+
+/**
+ * @brief Export the latest rendered frame as a binary PBM (P4) image
+ * @param buf Destination, at least DISPLAY_PBM_MAX_BYTES
+ * @param len Size of buf
+ * @return Bytes written, 0 if buf is too small
+ */
+size_t display_get_pbm(uint8_t *buf, size_t len);
+
 #endif // DISPLAY_H
@@ -0,0 +1,134 @@
+/**
+ * @file display_mirror.c
+ * @brief Compressed framebuffer mirror implementation
+ */
+
+#include <stdbool.h>
+
+#include "config.h"
+#include "display_mirror.h"
+#include "hal_clock.h"
+#include "hal_console.h"
+
+#define OLED_PAGES (OLED_HEIGHT / 8)
+
+#define MIRROR_MAGIC0 0xA5
+#define MIRROR_MAGIC1 0x5A
+#define MIRROR_FLAG_KEY 0x01
+#define MIRROR_HEADER 6
+
+// An all-literal page: one token per 128 bytes. Alternating runs would
+// cost 3 bytes per 2 columns, so the RLE falls back to this when it would
+// not fit.
+#define PAGE_MAX (OLED_WIDTH + (OLED_WIDTH + 127) / 128)
+
+static uint8_t s_frame[MIRROR_HEADER + OLED_PAGES * PAGE_MAX + 1];
+static const uint8_t s_blank[OLED_WIDTH]; // Keyframe reference
+static int64_t s_last_key_us = 0;
+static bool s_resync = false; // A frame was dropped; deltas are useless
+
+// ============================================================
+// ENCODER
+// ============================================================
+static int literal_page(uint8_t *out, const uint8_t *fb,
+                        const uint8_t *prev) {
+  uint8_t *p = out;
+
+  for (int x = 0; x < OLED_WIDTH; x += 128) {
+    int n = (OLED_WIDTH - x < 128) ? OLED_WIDTH - x : 128;
+    *p++ = (uint8_t)(0x80 + n - 1);
+    for (int i = x; i < x + n; i++)
+      *p++ = fb[i] ^ prev[i];
+  }
+  return (int)(p - out);
+}
+
+// RLE of one page of (fb ^ prev) into at most PAGE_MAX bytes; returns bytes
+// written, 0 if unchanged
+static int encode_page(uint8_t *out, const uint8_t *fb, const uint8_t *prev) {
+  uint8_t *p = out;
+  const uint8_t *end = out + PAGE_MAX;
+  int x = 0;
+  bool changed = false;
+
+  while (x < OLED_WIDTH) {
+    // Room for a token and one literal, else the run mix is too dense
+    if (end - p < 2)
+      return literal_page(out, fb, prev);
+
+    int start = x;
+    if ((fb[x] ^ prev[x]) == 0) {
+      while (x < OLED_WIDTH && x - start < 128 && (fb[x] ^ prev[x]) == 0)
+        x++;
+      *p++ = (uint8_t)(x - start - 1);
+    } else {
+      uint8_t *token = p++;
+      while (x < OLED_WIDTH && x - start < 128 && p < end &&
+             (fb[x] ^ prev[x]) != 0) {
+        *p++ = fb[x] ^ prev[x];
+        x++;
+      }
+      *token = (uint8_t)(0x80 + x - start - 1);
+      changed = true;
+    }
+  }
+  return changed ? (int)(p - out) : 0;
+}
+
+static void send_frame(const uint8_t *fb, const uint8_t *prev,
+                       int first_page, int last_page) {
+  uint8_t *payload = &s_frame[MIRROR_HEADER];
+  uint8_t mask = 0;
+  int len = 0;
+
+  for (int page = first_page; page <= last_page; page++) {
+    int n = encode_page(&payload[len], &fb[page * OLED_WIDTH],
+                        prev ? &prev[page * OLED_WIDTH] : s_blank);
+    if (n) {
+      mask |= (uint8_t)(1 << page);
+      len += n;
+    }
+  }
+  if (!mask && prev) {
+    return; // Nothing changed
+  }
+
+  s_frame[0] = MIRROR_MAGIC0;
+  s_frame[1] = MIRROR_MAGIC1;
+  s_frame[2] = prev ? 0 : MIRROR_FLAG_KEY;
+  s_frame[3] = mask;
+  s_frame[4] = (uint8_t)len;
+  s_frame[5] = (uint8_t)(len >> 8);
+
+  uint8_t sum = 0;
+  for (int i = 2; i < MIRROR_HEADER + len; i++)
+    sum += s_frame[i];
+  s_frame[MIRROR_HEADER + len] = sum;
+
+  // The console never blocks the display task; a dropped delta leaves the
+  // viewer out of step, so keyframes follow until one gets through
+  s_resync = !hal_console_write(s_frame, MIRROR_HEADER + len + 1);
+}
+
+// ============================================================
+// PUBLIC API
+// ============================================================
+void display_mirror_send(const uint8_t *fb, const uint8_t *prev,
+                         int first_page, int last_page) {
+  if (!prev || s_resync) {
+    // Keyframe: blank pages are left out of the mask
+    send_frame(fb, NULL, 0, OLED_PAGES - 1);
+    s_last_key_us = hal_time_us();
+    return;
+  }
+  send_frame(fb, prev, first_page, last_page);
+}
+
+void display_mirror_poll(const uint8_t *shown, int64_t now_us) {
+  if (!s_resync &&
+      now_us - s_last_key_us < DISPLAY_MIRROR_KEYFRAME_MS * 1000) {
+    return;
+  }
+  send_frame(shown, NULL, 0, OLED_PAGES - 1);
+  s_last_key_us = now_us;
+}
@@ -0,0 +1,44 @@
+/**
+ * @file display_mirror.h
+ * @brief Compressed framebuffer mirror on the serial console
+ *
+ * Each flush is sent as the XOR of the new pages against what the panel
+ * showed, run-length encoded, so unchanged columns cost almost nothing and
+ * a static screen sends nothing but a periodic keyframe. Encoding is
+ * O(128) per page into a static buffer; nothing is allocated. A page whose
+ * RLE would outgrow a plain literal run is sent as one. Frames go through
+ * the non-blocking hal_console_write(); after a drop, keyframes are sent
+ * until one gets through.
+ *
+ * Frame: A5 5A | flags | page mask | length (LE16) | payload | sum8
+ *   flags bit 0: keyframe (XOR against a blank screen; pages not in the
+ *                mask are blank)
+ *   payload: one RLE stream per page in the mask, in page order, each
+ *   decoding to exactly OLED_WIDTH bytes:
+ *     0x00-0x7F: n + 1 zero bytes
+ *     0x80-0xFF: n - 0x7F literal bytes follow
+ *   sum8: sum of flags .. end of payload, modulo 256
+ */
+
+#ifndef DISPLAY_MIRROR_H
+#define DISPLAY_MIRROR_H
+
+#include <stdint.h>
+
+/**
+ * @brief Send the pages about to be flushed
+ * @param fb New framebuffer
+ * @param prev What the panel shows now, NULL = unknown (keyframe)
+ * @param first_page, last_page Flushed page range (ignored for keyframes)
+ */
+void display_mirror_send(const uint8_t *fb, const uint8_t *prev,
+                         int first_page, int last_page);
+
+/**
+ * @brief Send a keyframe of the shown image if one is due
+ * @param shown What the panel shows
+ * @param now_us Current time
+ */
+void display_mirror_poll(const uint8_t *shown, int64_t now_us);
+
+#endif // DISPLAY_MIRROR_H
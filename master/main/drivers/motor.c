@@ -3,43 +3,110 @@
  * @brief Motor control for Mecanum wheel robot
  */
 
-#include "driver/gpio.h"
-#include "driver/ledc.h"
-#include "esp_log.h"
-
 #include "config.h"
+#include "hal_gpio.h"
+#include "hal_log.h"
 #include "motor.h"
+#include "motor_pwm.h"
+#include "motor_ramp.h"
 
 static const char *TAG = "MOTOR";
 
+// Direction pins are written through the GPIO0..31 set/clear masks
+_Static_assert(PIN_FL_IN1 < 32 && PIN_FL_IN2 < 32 && PIN_FR_IN1 < 32 &&
+                   PIN_FR_IN2 < 32 && PIN_BL_IN1 < 32 && PIN_BL_IN2 < 32 &&
+                   PIN_BR_IN1 < 32 && PIN_BR_IN2 < 32,
+               "motor IN pins must be GPIO0..31");
+
+typedef struct {
+  uint32_t in1_mask;
+  uint32_t in2_mask;
+} motor_hw_t;
+
+// Wheel order FL, FR, BL, BR
+static const motor_hw_t s_hw[4] = {
+    {1UL << PIN_FL_IN1, 1UL << PIN_FL_IN2},
+    {1UL << PIN_FR_IN1, 1UL << PIN_FR_IN2},
+    {1UL << PIN_BL_IN1, 1UL << PIN_BL_IN2},
+    {1UL << PIN_BR_IN1, 1UL << PIN_BR_IN2},
+};
+
 // Calibration values (0-255, default 255 = no reduction)
-static uint8_t s_cal_fl = DEFAULT_MOTOR_CAL;
-static uint8_t s_cal_fr = DEFAULT_MOTOR_CAL;
-static uint8_t s_cal_bl = DEFAULT_MOTOR_CAL;
-static uint8_t s_cal_br = DEFAULT_MOTOR_CAL;
+static uint8_t s_cal[4] = {DEFAULT_MOTOR_CAL, DEFAULT_MOTOR_CAL,
+                           DEFAULT_MOTOR_CAL, DEFAULT_MOTOR_CAL};
+
+// Last signed duty (backend ticks) written per wheel
+static int32_t s_out[4];
+static bool s_out_valid = false;
+// Last speeds requested of the output stage (after the ramp)
+static motor_speeds_t s_applied;
+static motor_write_stats_t s_stats;
 
 // ============================================================
-// SET SINGLE MOTOR
+// OUTPUT STAGE
 // ============================================================
-static void set_motor(int ena_ch, int in1_pin, int in2_pin, int16_t speed,
-                      uint8_t cal) {
-  // Apply calibration
-  int16_t calibrated_speed = (speed * cal) / 255;
-
-  if (calibrated_speed > 0) {
-    gpio_set_level(in1_pin, 1);
-    gpio_set_level(in2_pin, 0);
-    ledc_set_duty(LEDC_LOW_SPEED_MODE, ena_ch, calibrated_speed);
-  } else if (calibrated_speed < 0) {
-    gpio_set_level(in1_pin, 0);
-    gpio_set_level(in2_pin, 1);
-    ledc_set_duty(LEDC_LOW_SPEED_MODE, ena_ch, -calibrated_speed);
-  } else {
-    gpio_set_level(in1_pin, 0);
-    gpio_set_level(in2_pin, 0);
-    ledc_set_duty(LEDC_LOW_SPEED_MODE, ena_ch, 0);
+// Write signed duties in backend ticks; unchanged wheels are skipped, all
+// direction pins change in one set/clear pair and the backend latches the
+// changed channels together. New duties only reach the pins at the next
+// PWM period boundary, so a wheel that reverses is cut first: its old duty
+// would otherwise drive the new direction until then.
+static void write_outputs(const int32_t duty[4]) {
+  uint32_t set_mask = 0;
+  uint32_t clr_mask = 0;
+  bool changed[4];
+  int n_changed = 0;
+
+  for (int i = 0; i < 4; i++) {
+    if (s_out_valid && ((s_out[i] > 0 && duty[i] < 0) ||
+                        (s_out[i] < 0 && duty[i] > 0))) {
+      motor_pwm_cut(i);
+    }
+  }
+
+  for (int i = 0; i < 4; i++) {
+    changed[i] = !s_out_valid || duty[i] != s_out[i];
+    if (!changed[i]) {
+      continue;
+    }
+    n_changed++;
+
+    if (duty[i] > 0) {
+      set_mask |= s_hw[i].in1_mask;
+      clr_mask |= s_hw[i].in2_mask;
+    } else if (duty[i] < 0) {
+      set_mask |= s_hw[i].in2_mask;
+      clr_mask |= s_hw[i].in1_mask;
+    } else {
+      clr_mask |= s_hw[i].in1_mask | s_hw[i].in2_mask;
+    }
+    motor_pwm_set_duty(i, (uint32_t)(duty[i] < 0 ? -duty[i] : duty[i]));
+  }
+
+  s_stats.skipped += 4 - n_changed;
+  if (n_changed == 0) {
+    return;
+  }
+  s_stats.performed += n_changed;
+
+  // Clear first so no wheel ever sees IN1 = IN2 = 1
+  hal_gpio_write_masks(set_mask, clr_mask);
+
+  motor_pwm_latch();
+
+  for (int i = 0; i < 4; i++) {
+    s_out[i] = duty[i];
+  }
+  s_out_valid = true;
+}
+
+// Signed speed (-255..255) times calibration (0..255) in backend ticks
+static int32_t scale_duty(int16_t speed, uint8_t cal) {
+  int32_t mag = speed < 0 ? -speed : speed;
+  if (mag > MAX_SPEED) {
+    mag = MAX_SPEED;
   }
-  ledc_update_duty(LEDC_LOW_SPEED_MODE, ena_ch);
+  mag = (mag * cal * MOTOR_PWM_MAX_DUTY + (255 * 255) / 2) / (255 * 255);
+  return speed < 0 ? -mag : mag;
 }
 
 // ============================================================
@@ -47,57 +114,15 @@ static void set_motor(int ena_ch, int in1_pin, int in2_pin, int16_t speed,
 // ============================================================
 void motor_init(void) {
   // Configure direction pins as outputs
-  gpio_config_t io_conf = {
-      .mode = GPIO_MODE_OUTPUT,
-      .pull_up_en = GPIO_PULLUP_DISABLE,
-      .pull_down_en = GPIO_PULLDOWN_DISABLE,
-      .intr_type = GPIO_INTR_DISABLE,
-      .pin_bit_mask = (1ULL << PIN_FL_IN1) | (1ULL << PIN_FL_IN2) |
-                      (1ULL << PIN_FR_IN1) | (1ULL << PIN_FR_IN2) |
-                      (1ULL << PIN_BL_IN1) | (1ULL << PIN_BL_IN2) |
-                      (1ULL << PIN_BR_IN1) | (1ULL << PIN_BR_IN2),
-  };
-  gpio_config(&io_conf);
-
-  // Configure LEDC timer for motors
-  ledc_timer_config_t timer_conf = {
-      .speed_mode = LEDC_LOW_SPEED_MODE,
-      .duty_resolution = MOTOR_PWM_RES,
-      .timer_num = MOTOR_PWM_TIMER,
-      .freq_hz = MOTOR_PWM_FREQ,
-      .clk_cfg = LEDC_AUTO_CLK,
-  };
-  ESP_ERROR_CHECK(ledc_timer_config(&timer_conf));
-
-  // Configure LEDC channels
-  ledc_channel_config_t ch_conf = {
-      .speed_mode = LEDC_LOW_SPEED_MODE,
-      .timer_sel = MOTOR_PWM_TIMER,
-      .duty = 0,
-      .hpoint = 0,
-      .intr_type = LEDC_INTR_DISABLE,
-  };
-
-  // FL motor
-  ch_conf.channel = MOTOR_CH_FL;
-  ch_conf.gpio_num = PIN_FL_ENA;
-  ESP_ERROR_CHECK(ledc_channel_config(&ch_conf));
-
-  // FR motor
-  ch_conf.channel = MOTOR_CH_FR;
-  ch_conf.gpio_num = PIN_FR_ENA;
-  ESP_ERROR_CHECK(ledc_channel_config(&ch_conf));
-
-  // BL motor
-  ch_conf.channel = MOTOR_CH_BL;
-  ch_conf.gpio_num = PIN_BL_ENA;
-  ESP_ERROR_CHECK(ledc_channel_config(&ch_conf));
-
-  // BR motor
-  ch_conf.channel = MOTOR_CH_BR;
-  ch_conf.gpio_num = PIN_BR_ENA;
-  ESP_ERROR_CHECK(ledc_channel_config(&ch_conf));
+  hal_gpio_config_outputs(
+      (1ULL << PIN_FL_IN1) | (1ULL << PIN_FL_IN2) | (1ULL << PIN_FR_IN1) |
+      (1ULL << PIN_FR_IN2) | (1ULL << PIN_BL_IN1) | (1ULL << PIN_BL_IN2) |
+      (1ULL << PIN_BR_IN1) | (1ULL << PIN_BR_IN2));
+
+  motor_pwm_init();
 
+  // Fresh backend: the first write must reach every wheel
+  s_out_valid = false;
   motor_stop_all();
 
   ESP_LOGI(TAG, "Motor control initialized");
@@ -107,30 +132,36 @@ void motor_init(void) {
 // STOP ALL MOTORS
 // ============================================================
 void motor_stop_all(void) {
-  set_motor(MOTOR_CH_FL, PIN_FL_IN1, PIN_FL_IN2, 0, 255);
-  set_motor(MOTOR_CH_FR, PIN_FR_IN1, PIN_FR_IN2, 0, 255);
-  set_motor(MOTOR_CH_BL, PIN_BL_IN1, PIN_BL_IN2, 0, 255);
-  set_motor(MOTOR_CH_BR, PIN_BR_IN1, PIN_BR_IN2, 0, 255);
+  // Outputs jump to zero, so the ramp restarts from standstill
+  motor_ramp_reset();
+
+  static const int32_t zero[4] = {0, 0, 0, 0};
+  s_applied = (motor_speeds_t){0, 0, 0, 0};
+  write_outputs(zero);
 }
 
 // ============================================================
 // APPLY MOTOR SPEEDS
 // ============================================================
 void motor_apply_speeds(const motor_speeds_t *speeds) {
-  set_motor(MOTOR_CH_FL, PIN_FL_IN1, PIN_FL_IN2, speeds->fl, s_cal_fl);
-  set_motor(MOTOR_CH_FR, PIN_FR_IN1, PIN_FR_IN2, speeds->fr, s_cal_fr);
-  set_motor(MOTOR_CH_BL, PIN_BL_IN1, PIN_BL_IN2, speeds->bl, s_cal_bl);
-  set_motor(MOTOR_CH_BR, PIN_BR_IN1, PIN_BR_IN2, speeds->br, s_cal_br);
+  const int16_t req[4] = {speeds->fl, speeds->fr, speeds->bl, speeds->br};
+  int32_t duty[4];
+
+  for (int i = 0; i < 4; i++) {
+    duty[i] = scale_duty(req[i], s_cal[i]);
+  }
+  s_applied = *speeds;
+  write_outputs(duty);
 }
 
 // ============================================================
 // SET CALIBRATION
 // ============================================================
 void motor_set_calibration(uint8_t fl, uint8_t fr, uint8_t bl, uint8_t br) {
-  s_cal_fl = fl;
-  s_cal_fr = fr;
-  s_cal_bl = bl;
-  s_cal_br = br;
+  s_cal[0] = fl;
+  s_cal[1] = fr;
+  s_cal[2] = bl;
+  s_cal[3] = br;
   ESP_LOGI(TAG, "Calibration set: FL=%d FR=%d BL=%d BR=%d", fl, fr, bl, br);
 }
 
@@ -138,24 +169,23 @@ void motor_set_calibration(uint8_t fl, uint8_t fr, uint8_t bl, uint8_t br) {
 // TEST SINGLE MOTOR
 // ============================================================
 void motor_test(uint8_t motor_id, int16_t speed) {
-  motor_stop_all();
-
-  switch (motor_id) {
-  case 0:
-    set_motor(MOTOR_CH_FL, PIN_FL_IN1, PIN_FL_IN2, speed, 255);
-    ESP_LOGI(TAG, "Testing FL motor, speed=%d", speed);
-    break;
-  case 1:
-    set_motor(MOTOR_CH_FR, PIN_FR_IN1, PIN_FR_IN2, speed, 255);
-    ESP_LOGI(TAG, "Testing FR motor, speed=%d", speed);
-    break;
-  case 2:
-    set_motor(MOTOR_CH_BL, PIN_BL_IN1, PIN_BL_IN2, speed, 255);
-    ESP_LOGI(TAG, "Testing BL motor, speed=%d", speed);
-    break;
-  case 3:
-    set_motor(MOTOR_CH_BR, PIN_BR_IN1, PIN_BR_IN2, speed, 255);
-    ESP_LOGI(TAG, "Testing BR motor, speed=%d", speed);
-    break;
+  static const char *const names[4] = {"FL", "FR", "BL", "BR"};
+  int32_t duty[4] = {0, 0, 0, 0};
+  int16_t req[4] = {0, 0, 0, 0};
+
+  motor_ramp_reset();
+  if (motor_id < 4) {
+    duty[motor_id] = scale_duty(speed, 255);
+    req[motor_id] = speed;
+    ESP_LOGI(TAG, "Testing %s motor, speed=%d", names[motor_id], speed);
   }
+  s_applied = (motor_speeds_t){req[0], req[1], req[2], req[3]};
+  write_outputs(duty);
 }
+
+// ============================================================
+// STATISTICS
+// ============================================================
+void motor_get_write_stats(motor_write_stats_t *out) { *out = s_stats; }
+
+void motor_get_applied(motor_speeds_t *out) { *out = s_applied; }
@@ -6,8 +6,18 @@
 #ifndef MOTOR_H
 #define MOTOR_H
 
+#include <stdint.h>
+
 #include "types.h"
 
+/**
+ * @brief Output stage counters (one count per wheel per write request)
+ */
+typedef struct {
+  uint32_t performed; // Wheel outputs actually written
+  uint32_t skipped;   // Wheel outputs already at the requested value
+} motor_write_stats_t;
+
 /**
  * @brief Initialize motor control (GPIO and PWM)
  */
@@ -37,4 +47,16 @@ void motor_set_calibration(uint8_t fl, uint8_t fr, uint8_t bl, uint8_t br);
  */
 void motor_test(uint8_t motor_id, int16_t speed);
 
+/**
+ * @brief Get output stage counters
+ * @param out Destination
+ */
+void motor_get_write_stats(motor_write_stats_t *out);
+
+/**
+ * @brief Get the speeds the wheels are driven at (ramped, zero after a stop)
+ * @param out Destination
+ */
+void motor_get_applied(motor_speeds_t *out);
+
 #endif // MOTOR_H
@@ -0,0 +1,42 @@
+/**
+ * @file motor_pwm.h
+ * @brief PWM backend of the motor driver (LEDC, MCPWM or host mock)
+ *
+ * Exactly one backend is linked, chosen by MOTOR_PWM_BACKEND. Duties are
+ * in backend ticks, 0..MOTOR_PWM_MAX_DUTY. Wheel order is FL, FR, BL, BR.
+ */
+
+#ifndef MOTOR_PWM_H
+#define MOTOR_PWM_H
+
+#include <stdint.h>
+
+/**
+ * @brief Configure the PWM peripheral with all duties at 0
+ */
+void motor_pwm_init(void);
+
+/**
+ * @brief Stage a new duty for one wheel (not yet visible on the pin)
+ * @param wheel Wheel index 0..3
+ * @param duty Duty in ticks (0..MOTOR_PWM_MAX_DUTY)
+ */
+void motor_pwm_set_duty(int wheel, uint32_t duty);
+
+/**
+ * @brief Make every staged duty take effect together
+ */
+void motor_pwm_latch(void);
+
+/**
+ * @brief Drive one wheel's output low at once, without waiting for the
+ *        period boundary a latch waits for
+ *
+ * For direction changes: the old duty must not reach the motor through
+ * the new direction pins. The next set_duty / latch of the wheel lifts it.
+ *
+ * @param wheel Wheel index 0..3
+ */
+void motor_pwm_cut(int wheel);
+
+#endif // MOTOR_PWM_H
@@ -0,0 +1,85 @@
+/**
+ * @file motor_pwm_ledc.c
+ * @brief LEDC motor PWM backend (8-bit)
+ *
+ * LEDC channels latch independently, so staged channels are updated back
+ * to back in motor_pwm_latch().
+ */
+
+#include "config.h"
+
+#if MOTOR_PWM_BACKEND == MOTOR_PWM_BACKEND_LEDC
+
+#include "driver/ledc.h"
+#include "esp_log.h"
+
+#include "motor_pwm.h"
+
+static const char *TAG = "MOTOR_PWM";
+
+static const struct {
+  ledc_channel_t ch;
+  int gpio;
+} s_channels[4] = {
+    {MOTOR_CH_FL, PIN_FL_ENA},
+    {MOTOR_CH_FR, PIN_FR_ENA},
+    {MOTOR_CH_BL, PIN_BL_ENA},
+    {MOTOR_CH_BR, PIN_BR_ENA},
+};
+
+static uint8_t s_pending = 0;
+
+// ============================================================
+// INITIALIZATION
+// ============================================================
+void motor_pwm_init(void) {
+  ledc_timer_config_t timer_conf = {
+      .speed_mode = LEDC_LOW_SPEED_MODE,
+      .duty_resolution = MOTOR_PWM_RES,
+      .timer_num = MOTOR_PWM_TIMER,
+      .freq_hz = MOTOR_PWM_FREQ,
+      .clk_cfg = LEDC_AUTO_CLK,
+  };
+  ESP_ERROR_CHECK(ledc_timer_config(&timer_conf));
+
+  ledc_channel_config_t ch_conf = {
+      .speed_mode = LEDC_LOW_SPEED_MODE,
+      .timer_sel = MOTOR_PWM_TIMER,
+      .duty = 0,
+      .hpoint = 0,
+      .intr_type = LEDC_INTR_DISABLE,
+  };
+
+  for (int i = 0; i < 4; i++) {
+    ch_conf.channel = s_channels[i].ch;
+    ch_conf.gpio_num = s_channels[i].gpio;
+    ESP_ERROR_CHECK(ledc_channel_config(&ch_conf));
+  }
+
+  ESP_LOGI(TAG, "LEDC backend, %d Hz, max duty %d", MOTOR_PWM_FREQ,
+           MOTOR_PWM_MAX_DUTY);
+}
+
+// ============================================================
+// DUTY UPDATES
+// ============================================================
+void motor_pwm_set_duty(int wheel, uint32_t duty) {
+  ledc_set_duty(LEDC_LOW_SPEED_MODE, s_channels[wheel].ch, duty);
+  s_pending |= 1U << wheel;
+}
+
+void motor_pwm_latch(void) {
+  for (int i = 0; i < 4; i++) {
+    if (s_pending & (1U << i)) {
+      ledc_update_duty(LEDC_LOW_SPEED_MODE, s_channels[i].ch);
+    }
+  }
+  s_pending = 0;
+}
+
+void motor_pwm_cut(int wheel) {
+  // Idle low at once; ledc_update_duty() enables the output again
+  ledc_stop(LEDC_LOW_SPEED_MODE, s_channels[wheel].ch, 0);
+}
+
+#endif // MOTOR_PWM_BACKEND == MOTOR_PWM_BACKEND_LEDC
@@ -0,0 +1,114 @@
+/**
+ * @file motor_pwm_mcpwm.c
+ * @brief MCPWM motor PWM backend (~12-bit, synchronized)
+ *
+ * One timer in MCPWM group 0 drives two operators with two comparator /
+ * generator pairs each. Comparators reload on timer zero, so every wheel
+ * picks up its new duty at the same period boundary. 0 % and 100 % are
+ * forced generator levels instead: a compare of 0 or of the full period
+ * coincides with the timer-zero action, and the force acts at once.
+ */
+
+#include "config.h"
+
+#if MOTOR_PWM_BACKEND == MOTOR_PWM_BACKEND_MCPWM
+
+#include "driver/mcpwm_prelude.h"
+#include "esp_log.h"
+
+#include "motor_pwm.h"
+
+static const char *TAG = "MOTOR_PWM";
+
+static const int s_gpio[4] = {PIN_FL_ENA, PIN_FR_ENA, PIN_BL_ENA,
+                              PIN_BR_ENA};
+
+static mcpwm_timer_handle_t s_timer = NULL;
+static mcpwm_oper_handle_t s_oper[2];
+static mcpwm_cmpr_handle_t s_cmpr[4];
+static mcpwm_gen_handle_t s_gen[4];
+
+// Staged duties not yet latched (bit n = wheel n)
+static uint32_t s_staged[4];
+static uint8_t s_pending = 0;
+
+// ============================================================
+// INITIALIZATION
+// ============================================================
+void motor_pwm_init(void) {
+  mcpwm_timer_config_t timer_conf = {
+      .group_id = 0,
+      .clk_src = MCPWM_TIMER_CLK_SRC_DEFAULT,
+      .resolution_hz = MOTOR_MCPWM_RES_HZ,
+      .count_mode = MCPWM_TIMER_COUNT_MODE_UP,
+      .period_ticks = MOTOR_MCPWM_PERIOD_TICKS,
+  };
+  ESP_ERROR_CHECK(mcpwm_new_timer(&timer_conf, &s_timer));
+
+  mcpwm_operator_config_t oper_conf = {.group_id = 0};
+  mcpwm_comparator_config_t cmpr_conf = {.flags.update_cmp_on_tez = true};
+
+  for (int op = 0; op < 2; op++) {
+    ESP_ERROR_CHECK(mcpwm_new_operator(&oper_conf, &s_oper[op]));
+    ESP_ERROR_CHECK(mcpwm_operator_connect_timer(s_oper[op], s_timer));
+  }
+
+  // Wheels 0/1 on operator 0, wheels 2/3 on operator 1
+  for (int i = 0; i < 4; i++) {
+    mcpwm_oper_handle_t op = s_oper[i / 2];
+    mcpwm_generator_config_t gen_conf = {.gen_gpio_num = s_gpio[i]};
+
+    ESP_ERROR_CHECK(mcpwm_new_comparator(op, &cmpr_conf, &s_cmpr[i]));
+    ESP_ERROR_CHECK(mcpwm_new_generator(op, &gen_conf, &s_gen[i]));
+    ESP_ERROR_CHECK(mcpwm_comparator_set_compare_value(s_cmpr[i], 0));
+    ESP_ERROR_CHECK(mcpwm_generator_set_force_level(s_gen[i], 0, true));
+
+    // High from timer zero until the compare match
+    ESP_ERROR_CHECK(mcpwm_generator_set_action_on_timer_event(
+        s_gen[i],
+        MCPWM_GEN_TIMER_EVENT_ACTION(MCPWM_TIMER_DIRECTION_UP,
+                                     MCPWM_TIMER_EVENT_EMPTY,
+                                     MCPWM_GEN_ACTION_HIGH)));
+    ESP_ERROR_CHECK(mcpwm_generator_set_action_on_compare_event(
+        s_gen[i],
+        MCPWM_GEN_COMPARE_EVENT_ACTION(MCPWM_TIMER_DIRECTION_UP, s_cmpr[i],
+                                       MCPWM_GEN_ACTION_LOW)));
+  }
+
+  ESP_ERROR_CHECK(mcpwm_timer_enable(s_timer));
+  ESP_ERROR_CHECK(mcpwm_timer_start_stop(s_timer, MCPWM_TIMER_START_NO_STOP));
+
+  ESP_LOGI(TAG, "MCPWM backend, %d Hz, max duty %d", MOTOR_PWM_FREQ,
+           MOTOR_PWM_MAX_DUTY);
+}
+
+// ============================================================
+// DUTY UPDATES
+// ============================================================
+void motor_pwm_set_duty(int wheel, uint32_t duty) {
+  // Comparators reload on timer zero, all wheels together
+  mcpwm_comparator_set_compare_value(s_cmpr[wheel], duty);
+  s_staged[wheel] = duty;
+  s_pending |= 1U << wheel;
+}
+
+void motor_pwm_latch(void) {
+  for (int i = 0; i < 4; i++) {
+    if (!(s_pending & (1U << i))) {
+      continue;
+    }
+    // Lifting a force leaves the output as it is until the next timer
+    // event, which is also when the new compare value loads
+    int level = (s_staged[i] == 0)                    ? 0
+                : (s_staged[i] >= MOTOR_PWM_MAX_DUTY) ? 1
+                                                      : -1;
+    mcpwm_generator_set_force_level(s_gen[i], level, true);
+  }
+  s_pending = 0;
+}
+
+void motor_pwm_cut(int wheel) {
+  mcpwm_generator_set_force_level(s_gen[wheel], 0, true);
+}
+
+#endif // MOTOR_PWM_BACKEND == MOTOR_PWM_BACKEND_MCPWM
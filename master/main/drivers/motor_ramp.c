@@ -0,0 +1,149 @@
+/**
+ * @file motor_ramp.c
+ * @brief Per-wheel acceleration / jerk limited ramp implementation
+ *
+ * Duty is tracked in Q8 (1/256 duty step) so slow ramps still advance at
+ * 200 Hz; rates are Q8 per second.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "motor_ramp.h"
+
+typedef struct {
+  uint16_t accel; // duty/s while |duty| grows
+  uint16_t decel; // duty/s while |duty| shrinks
+} ramp_limits_t;
+
+typedef struct {
+  int32_t pos;  // Duty, Q8
+  int32_t rate; // Duty/s, Q8 (jerk mode only)
+} wheel_ramp_t;
+
+static ramp_limits_t s_limits[4];
+static uint16_t s_jerk = 0;
+static wheel_ramp_t s_wheels[4];
+
+// ============================================================
+// HELPERS
+// ============================================================
+static uint32_t isqrt64(uint64_t v) {
+  uint64_t r = 0;
+  uint64_t bit = 1ULL << 62;
+  while (bit > v)
+    bit >>= 2;
+  while (bit) {
+    if (v >= r + bit) {
+      v -= r + bit;
+      r = (r >> 1) + bit;
+    } else {
+      r >>= 1;
+    }
+    bit >>= 2;
+  }
+  return (uint32_t)r;
+}
+
+static int32_t clamp_abs(int32_t v, int32_t lim) {
+  if (v > lim)
+    return lim;
+  if (v < -lim)
+    return -lim;
+  return v;
+}
+
+// ============================================================
+// SINGLE WHEEL
+// ============================================================
+static int16_t step_wheel(wheel_ramp_t *w, const ramp_limits_t *lim,
+                          int16_t target, uint32_t dt_us) {
+  int32_t tgt = (int32_t)target << 8;
+  int32_t diff = tgt - w->pos;
+
+  if (diff == 0) {
+    w->rate = 0;
+    return target;
+  }
+
+  int32_t dir = (diff > 0) ? 1 : -1;
+  bool growing = (w->pos >= 0 && dir > 0) || (w->pos <= 0 && dir < 0);
+  uint16_t limit = growing ? lim->accel : lim->decel;
+
+  if (limit == 0) {
+    w->pos = tgt;
+    w->rate = 0;
+    return target;
+  }
+
+  int32_t v_max = (int32_t)limit << 8;
+  int32_t prev_rate;
+
+  if (s_jerk) {
+    // Slowest of the slope limit and the speed we can still brake from.
+    // Braking is judged from where this step leaves us; otherwise the slope
+    // trails the braking curve by a tick and the move ends with a jerk.
+    int64_t j = (int64_t)s_jerk << 8;
+    int64_t ahead =
+        (int64_t)abs(diff) - ((int64_t)abs(w->rate) * dt_us) / 1000000;
+    if (ahead < 0)
+      ahead = 0;
+    int32_t v_brake = (int32_t)isqrt64((uint64_t)(2 * j * ahead));
+    int32_t v_des = dir * ((v_brake < v_max) ? v_brake : v_max);
+    int32_t dv_max = (int32_t)((j * dt_us) / 1000000);
+    if (dv_max == 0)
+      dv_max = 1;
+    prev_rate = w->rate;
+    w->rate += clamp_abs(v_des - w->rate, dv_max);
+  } else {
+    w->rate = dir * v_max;
+    prev_rate = w->rate;
+  }
+
+  // Slope changes linearly over the step: advance by its mean
+  int32_t step =
+      (int32_t)(((int64_t)(prev_rate + w->rate) * dt_us) / 2000000);
+  if (step == 0)
+    step = (w->rate > 0) ? 1 : (w->rate < 0) ? -1 : 0;
+
+  // A reversal stops at zero, then grows with the accel limit for the
+  // rest of the step
+  if (!growing && (int64_t)w->pos * (w->pos + step) < 0) {
+    uint32_t used_us = (uint32_t)(((int64_t)abs(w->pos) * dt_us) / abs(step));
+    w->pos = 0;
+    w->rate = 0;
+    return step_wheel(w, lim, target, dt_us - used_us);
+  }
+
+  // Landing on (or passing) the target ends the ramp
+  if ((dir > 0 && step >= diff) || (dir < 0 && step <= diff)) {
+    w->pos = tgt;
+    w->rate = 0;
+    return target;
+  }
+
+  w->pos += step;
+  int32_t mag = (abs(w->pos) + 128) >> 8;
+  return (int16_t)((w->pos < 0) ? -mag : mag);
+}
+
+// ============================================================
+// PUBLIC API
+// ============================================================
+void motor_ramp_configure(const settings_data_t *settings) {
+  for (int i = 0; i < 4; i++) {
+    s_limits[i].accel = settings->ramp_accel[i];
+    s_limits[i].decel = settings->ramp_decel[i];
+  }
+  s_jerk = settings->ramp_jerk;
+}
+
+void motor_ramp_step(const motor_speeds_t *target, motor_speeds_t *out,
+                     uint32_t dt_us) {
+  out->fl = step_wheel(&s_wheels[0], &s_limits[0], target->fl, dt_us);
+  out->fr = step_wheel(&s_wheels[1], &s_limits[1], target->fr, dt_us);
+  out->bl = step_wheel(&s_wheels[2], &s_limits[2], target->bl, dt_us);
+  out->br = step_wheel(&s_wheels[3], &s_limits[3], target->br, dt_us);
+}
+
+void motor_ramp_reset(void) { memset(s_wheels, 0, sizeof(s_wheels)); }
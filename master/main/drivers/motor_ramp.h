@@ -0,0 +1,42 @@
+/**
+ * @file motor_ramp.h
+ * @brief Per-wheel acceleration / jerk limited ramp before the motor outputs
+ *
+ * The ramp sits between the mode's requested wheel speeds and
+ * motor_apply_speeds(). Each wheel's duty may grow in magnitude at most
+ * `accel` duty/s and shrink at most `decel` duty/s; a reversal first
+ * decelerates to zero. With a non-zero jerk limit the slope itself changes
+ * at most `jerk` duty/s^2 and tapers off before the target (S-curve).
+ *
+ * motor_stop_all() resets the ramp, so emergency stops are never ramped.
+ */
+
+#ifndef MOTOR_RAMP_H
+#define MOTOR_RAMP_H
+
+#include <stdint.h>
+
+#include "types.h"
+
+/**
+ * @brief Take ramp limits from the settings (0 = unlimited)
+ * @param settings ramp_accel / ramp_decel per wheel in duty/s, ramp_jerk in
+ *        duty/s^2 (0 = pure trapezoid)
+ */
+void motor_ramp_configure(const settings_data_t *settings);
+
+/**
+ * @brief Advance the ramp towards the requested speeds
+ * @param target Requested wheel speeds
+ * @param out Ramped wheel speeds
+ * @param dt_us Time since the previous step
+ */
+void motor_ramp_step(const motor_speeds_t *target, motor_speeds_t *out,
+                     uint32_t dt_us);
+
+/**
+ * @brief Drop ramp state to standstill (outputs already stopped)
+ */
+void motor_ramp_reset(void);
+
+#endif // MOTOR_RAMP_H
@@ -13,6 +13,24 @@
 
 static const char *TAG = "NVS";
 
+static const char *const s_ramp_accel_keys[4] = {
+    NVS_KEY_RAMP_ACCEL_FL, NVS_KEY_RAMP_ACCEL_FR, NVS_KEY_RAMP_ACCEL_BL,
+    NVS_KEY_RAMP_ACCEL_BR};
+static const char *const s_ramp_decel_keys[4] = {
+    NVS_KEY_RAMP_DECEL_FL, NVS_KEY_RAMP_DECEL_FR, NVS_KEY_RAMP_DECEL_BL,
+    NVS_KEY_RAMP_DECEL_BR};
+
+// ============================================================
+// RAMP DEFAULTS
+// ============================================================
+static void set_ramp_defaults(settings_data_t *settings) {
+  for (int i = 0; i < 4; i++) {
+    settings->ramp_accel[i] = DEFAULT_RAMP_ACCEL;
+    settings->ramp_decel[i] = DEFAULT_RAMP_DECEL;
+  }
+  settings->ramp_jerk = DEFAULT_RAMP_JERK;
+}
+
 // ============================================================
 // LOAD SETTINGS
 // ============================================================
@@ -28,6 +46,7 @@ void nvs_storage_load(settings_data_t *settings) {
     settings->motor_cal_fr = DEFAULT_MOTOR_CAL;
     settings->motor_cal_bl = DEFAULT_MOTOR_CAL;
     settings->motor_cal_br = DEFAULT_MOTOR_CAL;
+    set_ramp_defaults(settings);
     return;
   }
 
@@ -72,6 +91,14 @@ void nvs_storage_load(settings_data_t *settings) {
     settings->motor_cal_br = DEFAULT_MOTOR_CAL;
   }
 
+  // Wheel ramps (missing keys keep their default)
+  set_ramp_defaults(settings);
+  for (int i = 0; i < 4; i++) {
+    nvs_get_u16(handle, s_ramp_accel_keys[i], &settings->ramp_accel[i]);
+    nvs_get_u16(handle, s_ramp_decel_keys[i], &settings->ramp_decel[i]);
+  }
+  nvs_get_u16(handle, NVS_KEY_RAMP_JERK, &settings->ramp_jerk);
+
   nvs_close(handle);
 
   ESP_LOGI(TAG, "Settings loaded from NVS");
@@ -95,6 +122,11 @@ void nvs_storage_save(const settings_data_t *settings) {
   nvs_set_u8(handle, NVS_KEY_MOTOR_CAL_FR, settings->motor_cal_fr);
   nvs_set_u8(handle, NVS_KEY_MOTOR_CAL_BL, settings->motor_cal_bl);
   nvs_set_u8(handle, NVS_KEY_MOTOR_CAL_BR, settings->motor_cal_br);
+  for (int i = 0; i < 4; i++) {
+    nvs_set_u16(handle, s_ramp_accel_keys[i], settings->ramp_accel[i]);
+    nvs_set_u16(handle, s_ramp_decel_keys[i], settings->ramp_decel[i]);
+  }
+  nvs_set_u16(handle, NVS_KEY_RAMP_JERK, settings->ramp_jerk);
 
   nvs_commit(handle);
   nvs_close(handle);
@@ -0,0 +1,136 @@
+/**
+ * @file event_bus.c
+ * @brief System event queue and dispatcher
+ */
+
+#include <stdatomic.h>
+
+#include "config.h"
+#include "event_bus.h"
+#include "fsm.h"
+#include "hal_clock.h"
+#include "hal_log.h"
+#include "hal_queue.h"
+
+static const char *TAG = "EVENTS";
+
+// Queue storage
+static uint8_t s_queue_storage[EVENT_QUEUE_LEN * sizeof(system_event_t)];
+static hal_queue_t *s_queue = NULL;
+
+// Producer-side counters (posted from several tasks)
+static atomic_uint s_posted;
+static atomic_uint s_dropped;
+
+// Sees every event just before the FSM does (trace recording)
+static event_bus_trace_fn_t s_trace = NULL;
+
+// Dispatcher-side counters (executive task only)
+static uint32_t s_dispatched = 0;
+static uint32_t s_max_pending = 0;
+static uint32_t s_last_latency_us = 0;
+static uint32_t s_max_latency_us = 0;
+static uint64_t s_latency_sum_us = 0;
+
+// ============================================================
+// INITIALIZATION
+// ============================================================
+void event_bus_init(void) {
+  if (s_queue) {
+    // Re-initialization (host tests): drop whatever is still queued
+    system_event_t stale;
+    while (hal_queue_receive(s_queue, &stale)) {
+    }
+  } else {
+    s_queue = hal_queue_create(sizeof(system_event_t), EVENT_QUEUE_LEN,
+                               s_queue_storage);
+  }
+  ESP_LOGI(TAG, "Event bus ready (%d slots)", EVENT_QUEUE_LEN);
+}
+
+// ============================================================
+// POST
+// ============================================================
+static bool post(system_event_t *evt) {
+  evt->stamp_us = hal_time_us();
+
+  if (!hal_queue_send(s_queue, evt)) {
+    atomic_fetch_add_explicit(&s_dropped, 1, memory_order_relaxed);
+    return false;
+  }
+  atomic_fetch_add_explicit(&s_posted, 1, memory_order_relaxed);
+  return true;
+}
+
+bool event_bus_post(event_type_t type) {
+  system_event_t evt = {.type = type};
+  return post(&evt);
+}
+
+bool event_bus_post_button(button_event_t button) {
+  system_event_t evt = {.type = EVT_BUTTON, .data.button = button};
+  return post(&evt);
+}
+
+bool event_bus_post_joystick(const joystick_data_t *joy) {
+  system_event_t evt = {.type = EVT_JOYSTICK_DATA, .data.joystick = *joy};
+  return post(&evt);
+}
+
+bool event_bus_post_voice(uint8_t cmd, uint8_t speed) {
+  system_event_t evt = {.type = EVT_VOICE_CMD,
+                        .data.voice = {.cmd = cmd, .speed = speed}};
+  return post(&evt);
+}
+
+bool event_bus_post_state(system_state_t new_state) {
+  system_event_t evt = {.type = EVT_STATE_CHANGE, .data.new_state = new_state};
+  return post(&evt);
+}
+
+// ============================================================
+// DISPATCH
+// ============================================================
+int event_bus_dispatch_pending(void) {
+  size_t pending = hal_queue_pending(s_queue);
+  if (pending > s_max_pending) {
+    s_max_pending = pending;
+  }
+
+  // Bounded by what was queued on entry so producers cannot starve us
+  int count = 0;
+  system_event_t evt;
+  while (count < (int)pending && hal_queue_receive(s_queue, &evt)) {
+    if (s_trace) {
+      s_trace(&evt);
+    }
+    fsm_dispatch(&evt);
+    count++;
+
+    uint32_t latency = (uint32_t)(hal_time_us() - evt.stamp_us);
+    s_last_latency_us = latency;
+    s_latency_sum_us += latency;
+    if (latency > s_max_latency_us) {
+      s_max_latency_us = latency;
+    }
+  }
+
+  s_dispatched += count;
+  return count;
+}
+
+void event_bus_set_trace(event_bus_trace_fn_t fn) { s_trace = fn; }
+
+// ============================================================
+// STATISTICS
+// ============================================================
+void event_bus_get_stats(event_bus_stats_t *out) {
+  out->posted = atomic_load_explicit(&s_posted, memory_order_relaxed);
+  out->dropped = atomic_load_explicit(&s_dropped, memory_order_relaxed);
+  out->dispatched = s_dispatched;
+  out->max_pending = s_max_pending;
+  out->last_latency_us = s_last_latency_us;
+  out->max_latency_us = s_max_latency_us;
+  out->mean_latency_us =
+      s_dispatched ? (uint32_t)(s_latency_sum_us / s_dispatched) : 0;
+}
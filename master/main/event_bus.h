@@ -0,0 +1,98 @@
+/**
+ * @file event_bus.h
+ * @brief System event queue between producers and the FSM dispatcher
+ *
+ * Producers (buttons, radio callback, control tick) only post events; the
+ * dispatcher drains the queue on the executive task and hands each event
+ * to fsm_dispatch(). Posting never blocks and never allocates.
+ */
+
+#ifndef EVENT_BUS_H
+#define EVENT_BUS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "types.h"
+
+/**
+ * @brief Event bus statistics
+ */
+typedef struct {
+  uint32_t posted;
+  uint32_t dropped;         // Queue full at post time
+  uint32_t dispatched;
+  uint32_t max_pending;     // Deepest queue seen at drain time
+  uint32_t last_latency_us; // Post -> dispatch
+  uint32_t max_latency_us;
+  uint32_t mean_latency_us;
+} event_bus_stats_t;
+
+/**
+ * @brief Create the (statically allocated) event queue
+ */
+void event_bus_init(void);
+
+/**
+ * @brief Post an event, stamping it with the current time
+ *
+ * Safe from any task; returns immediately when the queue is full.
+ *
+ * @param type Event type
+ * @return false if the event was dropped
+ */
+bool event_bus_post(event_type_t type);
+
+/**
+ * @brief Post a button event
+ * @param evt Button event
+ * @return false if the event was dropped
+ */
+bool event_bus_post_button(button_event_t evt);
+
+/**
+ * @brief Post a received joystick frame
+ * @param joy Frame (copied into the event)
+ * @return false if the event was dropped
+ */
+bool event_bus_post_joystick(const joystick_data_t *joy);
+
+/**
+ * @brief Post a received voice command
+ * @param cmd Voice command
+ * @param speed Requested speed
+ * @return false if the event was dropped
+ */
+bool event_bus_post_voice(uint8_t cmd, uint8_t speed);
+
+/**
+ * @brief Post a state change request
+ * @param new_state Target state
+ * @return false if the event was dropped
+ */
+bool event_bus_post_state(system_state_t new_state);
+
+/**
+ * @brief Dispatch every pending event to the FSM
+ * @return Number of events dispatched
+ */
+int event_bus_dispatch_pending(void);
+
+/**
+ * @brief Receives each event as it is dispatched (dispatcher task)
+ */
+typedef void (*event_bus_trace_fn_t)(const system_event_t *evt);
+
+/**
+ * @brief Record dispatched events, e.g. for replay through fsm_dispatch()
+ * @param fn Trace function, or NULL to stop
+ */
+void event_bus_set_trace(event_bus_trace_fn_t fn);
+
+/**
+ * @brief Get event bus statistics
+ * @param out Destination
+ */
+void event_bus_get_stats(event_bus_stats_t *out);
+
+#endif // EVENT_BUS_H
@@ -7,7 +7,7 @@
 #include "buzzer.h"
 #include "config.h"
 #include "display.h"
-#include "esp_log.h"
+#include "hal_log.h"
 #include "mode_mecanum.h"
 #include "mode_menu.h"
 #include "mode_rc.h"
@@ -18,6 +18,9 @@
 
 static const char *TAG = "FSM";
 
+// Input has left neutral since the emergency stop latched
+static bool s_estop_moved = false;
+
 // ============================================================
 // INITIALIZATION
 // ============================================================
@@ -41,7 +44,13 @@ void fsm_change_state(system_state_t new_state) {
   // Exit current state
   switch (g_ctx.current_state) {
   case STATE_MODE_MECANUM:
+    mode_mecanum_exit();
+    motor_stop_all();
+    break;
   case STATE_MODE_RC:
+    mode_rc_exit();
+    motor_stop_all();
+    break;
   case STATE_MODE_VOICE:
     motor_stop_all();
     break;
@@ -49,6 +58,12 @@ void fsm_change_state(system_state_t new_state) {
     break;
   }
 
+  // Leaving the mode, wheels stopped, is the operator's acknowledgement
+  if (g_ctx.estop_latched) {
+    g_ctx.estop_latched = false;
+    ESP_LOGI(TAG, "Emergency stop cleared on mode exit");
+  }
+
   ESP_LOGI(TAG, "State change: %d -> %d", g_ctx.current_state, new_state);
 
   g_ctx.current_state = new_state;
@@ -96,6 +111,31 @@ void fsm_process_button(button_event_t evt) {
   }
 }
 
+// ============================================================
+// EMERGENCY STOP LATCH
+// ============================================================
+void fsm_estop_latch(void) {
+  g_ctx.estop_latched = true;
+  s_estop_moved = false;
+}
+
+movement_type_t fsm_estop_gate(movement_type_t classified) {
+  if (classified == MOVEMENT_EMERGENCY) {
+    fsm_estop_latch();
+  } else if (g_ctx.estop_latched) {
+    if (classified != MOVEMENT_STOP) {
+      s_estop_moved = true;
+      return MOVEMENT_EMERGENCY;
+    }
+    if (!s_estop_moved) {
+      return MOVEMENT_EMERGENCY; // Neutral since the stop: not a release
+    }
+    g_ctx.estop_latched = false;
+    ESP_LOGI(TAG, "Emergency stop released: input moved, back at neutral");
+  }
+  return classified;
+}
+
 // ============================================================
 // PROCESS JOYSTICK DATA
 // ============================================================
@@ -122,14 +162,43 @@ void fsm_process_voice(void) {
 }
 
 // ============================================================
-// FSM UPDATE (called from main loop)
+// INPUT FRAMES
 // ============================================================
-void fsm_update(void) {
-  // Check connection timeouts
-  uint32_t now = xTaskGetTickCount() * portTICK_PERIOD_MS;
+// Frames travel inside their events and time comes from the event stamp,
+// so replaying a recorded trace reproduces every g_ctx update.
+static void apply_joystick(const system_event_t *evt) {
+  g_ctx.joystick = evt->data.joystick;
+  g_ctx.joystick_frames++;
+  g_ctx.joystick_rx_us = evt->stamp_us;
+  g_ctx.last_joystick_time = (uint32_t)(evt->stamp_us / 1000);
+
+  if (!g_ctx.joystick_connected) {
+    g_ctx.joystick_connected = true;
+    g_ctx.display_dirty = true;
+    ESP_LOGI(TAG, "Joystick connected");
+  }
+}
 
+static void apply_voice(const system_event_t *evt) {
+  g_ctx.voice_cmd = evt->data.voice.cmd;
+  g_ctx.voice_speed = evt->data.voice.speed;
+  g_ctx.last_voice_time = (uint32_t)(evt->stamp_us / 1000);
+
+  if (!g_ctx.voice_connected) {
+    g_ctx.voice_connected = true;
+    g_ctx.display_dirty = true;
+    ESP_LOGI(TAG, "Voice slave connected");
+  }
+  ESP_LOGI(TAG, "Voice CMD: %d, Speed: %d", g_ctx.voice_cmd,
+           g_ctx.voice_speed);
+}
+
+// ============================================================
+// CONNECTION TIMEOUTS
+// ============================================================
+static void check_timeouts(uint32_t now) {
   if (g_ctx.joystick_connected &&
-      (now - g_ctx.last_joystick_time > CONNECTION_TIMEOUT_MS)) {
+      ((int32_t)(now - g_ctx.last_joystick_time) > CONNECTION_TIMEOUT_MS)) {
     g_ctx.joystick_connected = false;
     if (g_ctx.current_state == STATE_MODE_MECANUM ||
         g_ctx.current_state == STATE_MODE_RC) {
@@ -141,7 +210,7 @@ void fsm_update(void) {
   }
 
   if (g_ctx.voice_connected &&
-      (now - g_ctx.last_voice_time > CONNECTION_TIMEOUT_MS)) {
+      ((int32_t)(now - g_ctx.last_voice_time) > CONNECTION_TIMEOUT_MS)) {
     g_ctx.voice_connected = false;
     if (g_ctx.current_state == STATE_MODE_VOICE) {
       g_ctx.movement = MOVEMENT_STOP;
@@ -152,6 +221,33 @@ void fsm_update(void) {
   }
 }
 
+// ============================================================
+// DISPATCH EVENT
+// ============================================================
+void fsm_dispatch(const system_event_t *evt) {
+  switch (evt->type) {
+  case EVT_BUTTON:
+    fsm_process_button(evt->data.button);
+    break;
+  case EVT_JOYSTICK_DATA:
+    apply_joystick(evt);
+    break;
+  case EVT_VOICE_CMD:
+    apply_voice(evt);
+    break;
+  case EVT_TIMEOUT:
+    // Time comes from the event, so a replayed trace times out identically
+    check_timeouts((uint32_t)(evt->stamp_us / 1000));
+    break;
+  case EVT_STATE_CHANGE:
+    fsm_change_state(evt->data.new_state);
+    break;
+  case EVT_NONE:
+  default:
+    break;
+  }
+}
+
 // ============================================================
 // GET CURRENT STATE
 // ============================================================
@@ -36,9 +36,38 @@ void fsm_process_voice(void);
 void fsm_change_state(system_state_t new_state);
 
 /**
- * @brief Update current mode (called from main loop)
+ * @brief Latch the emergency stop (g_ctx.estop_latched)
+ *
+ * For a mode's OK long press; fsm_estop_gate() latches on
+ * MOVEMENT_EMERGENCY itself.
  */
-void fsm_update(void);
+void fsm_estop_latch(void);
+
+/**
+ * @brief Pass a mode's movement through the emergency stop latch
+ *
+ * MOVEMENT_EMERGENCY (stick button) or fsm_estop_latch() latches. While
+ * latched every movement reads as MOVEMENT_EMERGENCY, so the mode keeps
+ * its wheels at zero. Release takes a deliberate gesture: the input must
+ * leave neutral and then come back to it (stick moved and re-centred, or
+ * a voice movement command followed by stop), or the operator leaves the
+ * mode. Input that simply stays at neutral keeps the latch.
+ *
+ * @param classified Movement the mode derived from its input
+ * @return Movement the mode must apply
+ */
+movement_type_t fsm_estop_gate(movement_type_t classified);
+
+/**
+ * @brief Apply one event to the system context
+ *
+ * All g_ctx mutations caused by inputs and timeouts go through here, on
+ * the dispatcher task. The function reads no clock, so replaying the same
+ * event trace always gives the same result.
+ *
+ * @param evt Event to apply
+ */
+void fsm_dispatch(const system_event_t *evt);
 
 /**
  * @brief Get current state
@@ -0,0 +1,233 @@
+/**
+ * @file hal_esp.c
+ * @brief ESP-IDF implementation of the HAL
+ */
+
+#include <stdio.h>
+
+#include "driver/gpio.h"
+#include "driver/i2c_master.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/message_buffer.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "soc/gpio_reg.h"
+#include "soc/soc.h"
+
+#include "config.h"
+#include "hal_clock.h"
+#include "hal_console.h"
+#include "hal_gpio.h"
+#include "hal_i2c.h"
+#include "hal_queue.h"
+
+#define HAL_I2C_TIMEOUT_MS 100
+#define HAL_I2C_QUEUE_DEPTH 2
+
+#define HAL_CONSOLE_RING_BYTES 2048 // Two keyframes with their length words
+#define HAL_CONSOLE_TASK_PRIO 1
+#define HAL_CONSOLE_TASK_STACK 2048
+
+// ============================================================
+// CLOCK
+// ============================================================
+int64_t hal_time_us(void) { return esp_timer_get_time(); }
+
+void hal_delay_ms(uint32_t ms) { vTaskDelay(pdMS_TO_TICKS(ms)); }
+
+// ============================================================
+// GPIO
+// ============================================================
+void hal_gpio_config_outputs(uint64_t pin_mask) {
+  gpio_config_t io_conf = {
+      .mode = GPIO_MODE_OUTPUT,
+      .pull_up_en = GPIO_PULLUP_DISABLE,
+      .pull_down_en = GPIO_PULLDOWN_DISABLE,
+      .intr_type = GPIO_INTR_DISABLE,
+      .pin_bit_mask = pin_mask,
+  };
+  gpio_config(&io_conf);
+}
+
+void hal_gpio_write_masks(uint32_t set_mask, uint32_t clr_mask) {
+  REG_WRITE(GPIO_OUT_W1TC_REG, clr_mask);
+  REG_WRITE(GPIO_OUT_W1TS_REG, set_mask);
+}
+
+// ============================================================
+// I2C
+// ============================================================
+// One device on the bus (the OLED). Its done callback is registered, which
+// makes every i2c_master_transmit() asynchronous; blocking writes wait for
+// the callback on a semaphore.
+static i2c_master_bus_handle_t s_bus = NULL;
+static i2c_master_dev_handle_t s_dev = NULL;
+static uint8_t s_dev_addr = 0;
+static uint32_t s_freq_hz = 0;
+
+static StaticSemaphore_t s_sync_buf;
+static SemaphoreHandle_t s_sync_done = NULL;
+static volatile bool s_sync_ok = false;
+
+// Completion of the transaction in flight (one at a time). The lock lets a
+// timed-out blocking write detach its callback against the ISR.
+static hal_i2c_done_cb_t s_done_cb = NULL;
+static void *s_done_ctx = NULL;
+static portMUX_TYPE s_done_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static bool on_trans_done(i2c_master_dev_handle_t dev,
+                          const i2c_master_event_data_t *evt, void *arg) {
+  portENTER_CRITICAL_ISR(&s_done_lock);
+  hal_i2c_done_cb_t cb = s_done_cb;
+  void *ctx = s_done_ctx;
+  s_done_cb = NULL;
+  portEXIT_CRITICAL_ISR(&s_done_lock);
+  return cb ? cb(evt->event == I2C_EVENT_DONE, ctx) : false;
+}
+
+static bool sync_done(bool ok, void *ctx) {
+  BaseType_t woken = pdFALSE;
+  s_sync_ok = ok;
+  xSemaphoreGiveFromISR(s_sync_done, &woken);
+  return woken == pdTRUE;
+}
+
+static i2c_master_dev_handle_t get_device(uint8_t addr) {
+  if (s_dev) {
+    return (addr == s_dev_addr) ? s_dev : NULL;
+  }
+
+  i2c_device_config_t dev_conf = {
+      .dev_addr_length = I2C_ADDR_BIT_LEN_7,
+      .device_address = addr,
+      .scl_speed_hz = s_freq_hz,
+  };
+  if (i2c_master_bus_add_device(s_bus, &dev_conf, &s_dev) != ESP_OK) {
+    s_dev = NULL;
+    return NULL;
+  }
+
+  i2c_master_event_callbacks_t cbs = {.on_trans_done = on_trans_done};
+  i2c_master_register_event_callbacks(s_dev, &cbs, NULL);
+  s_dev_addr = addr;
+  return s_dev;
+}
+
+bool hal_i2c_init(int sda, int scl, uint32_t freq_hz) {
+  i2c_master_bus_config_t bus_conf = {
+      .i2c_port = OLED_I2C_NUM,
+      .sda_io_num = sda,
+      .scl_io_num = scl,
+      .clk_source = I2C_CLK_SRC_DEFAULT,
+      .glitch_ignore_cnt = 7,
+      .trans_queue_depth = HAL_I2C_QUEUE_DEPTH,
+      .flags.enable_internal_pullup = true,
+  };
+  if (i2c_new_master_bus(&bus_conf, &s_bus) != ESP_OK) {
+    return false;
+  }
+  s_freq_hz = freq_hz;
+  s_sync_done = xSemaphoreCreateBinaryStatic(&s_sync_buf);
+  return true;
+}
+
+bool hal_i2c_write_async(uint8_t addr, const uint8_t *data, size_t len,
+                         hal_i2c_done_cb_t cb, void *ctx) {
+  i2c_master_dev_handle_t dev = get_device(addr);
+  if (!dev) {
+    return false;
+  }
+
+  s_done_ctx = ctx;
+  s_done_cb = cb;
+  if (i2c_master_transmit(dev, data, len, -1) != ESP_OK) {
+    s_done_cb = NULL;
+    return false;
+  }
+  return true;
+}
+
+bool hal_i2c_write(uint8_t addr, const uint8_t *data, size_t len) {
+  if (!hal_i2c_write_async(addr, data, len, sync_done, NULL)) {
+    return false;
+  }
+  if (xSemaphoreTake(s_sync_done, pdMS_TO_TICKS(HAL_I2C_TIMEOUT_MS)) !=
+      pdTRUE) {
+    // The late completion must not answer the next write: detach the
+    // callback, let the bus finish (or reset it), then drop a stale give
+    portENTER_CRITICAL(&s_done_lock);
+    s_done_cb = NULL;
+    portEXIT_CRITICAL(&s_done_lock);
+    if (i2c_master_bus_wait_all_done(s_bus, HAL_I2C_TIMEOUT_MS) != ESP_OK) {
+      i2c_master_bus_reset(s_bus);
+    }
+    xSemaphoreTake(s_sync_done, 0);
+    return false;
+  }
+  return s_sync_ok;
+}
+
+// ============================================================
+// CONSOLE
+// ============================================================
+// A blocking fwrite of a keyframe holds the caller for tens of
+// milliseconds at 115200 baud, so units go through a message buffer and a
+// low-priority task writes them out. Same stream as the log output, and
+// one fwrite per unit, so a frame is never cut by a log line.
+static StaticMessageBuffer_t s_console_buf;
+static uint8_t s_console_storage[HAL_CONSOLE_RING_BYTES + 1];
+static MessageBufferHandle_t s_console = NULL;
+static uint8_t s_console_out[HAL_CONSOLE_MAX_WRITE];
+
+static void console_task(void *arg) {
+  for (;;) {
+    size_t n = xMessageBufferReceive(s_console, s_console_out,
+                                     sizeof(s_console_out), portMAX_DELAY);
+    fwrite(s_console_out, 1, n, stdout);
+    fflush(stdout);
+  }
+}
+
+bool hal_console_write(const uint8_t *data, size_t len) {
+  if (!s_console) {
+    // Single writer, so creating on first use cannot race
+    s_console = xMessageBufferCreateStatic(HAL_CONSOLE_RING_BYTES,
+                                           s_console_storage, &s_console_buf);
+    xTaskCreate(console_task, "console", HAL_CONSOLE_TASK_STACK, NULL,
+                HAL_CONSOLE_TASK_PRIO, NULL);
+  }
+  if (len > HAL_CONSOLE_MAX_WRITE) {
+    return false;
+  }
+  return xMessageBufferSend(s_console, data, len, 0) == len;
+}
+
+// ============================================================
+// QUEUE
+// ============================================================
+// The handle is the FreeRTOS queue itself
+static StaticQueue_t s_queue_buf[HAL_QUEUE_MAX];
+static int s_queue_count = 0;
+
+hal_queue_t *hal_queue_create(size_t item_size, size_t length,
+                              uint8_t *storage) {
+  if (s_queue_count == HAL_QUEUE_MAX) {
+    return NULL;
+  }
+  return (hal_queue_t *)xQueueCreateStatic(length, item_size, storage,
+                                           &s_queue_buf[s_queue_count++]);
+}
+
+bool hal_queue_send(hal_queue_t *q, const void *item) {
+  return xQueueSend((QueueHandle_t)q, item, 0) == pdTRUE;
+}
+
+bool hal_queue_receive(hal_queue_t *q, void *item) {
+  return xQueueReceive((QueueHandle_t)q, item, 0) == pdTRUE;
+}
+
+size_t hal_queue_pending(hal_queue_t *q) {
+  return uxQueueMessagesWaiting((QueueHandle_t)q);
+}
@@ -0,0 +1,22 @@
+/**
+ * @file hal_clock.h
+ * @brief Monotonic clock and delays
+ */
+
+#ifndef HAL_CLOCK_H
+#define HAL_CLOCK_H
+
+#include <stdint.h>
+
+/**
+ * @brief Microseconds since boot (monotonic)
+ */
+int64_t hal_time_us(void);
+
+/**
+ * @brief Block the calling task
+ * @param ms Delay in milliseconds
+ */
+void hal_delay_ms(uint32_t ms);
+
+#endif // HAL_CLOCK_H
@@ -0,0 +1,29 @@
+/**
+ * @file hal_console.h
+ * @brief Raw writes to the serial console (UART or USB-CDC)
+ */
+
+#ifndef HAL_CONSOLE_H
+#define HAL_CONSOLE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Largest unit hal_console_write() accepts (a display mirror keyframe is
+// at most 1039 bytes)
+#define HAL_CONSOLE_MAX_WRITE 1040
+
+/**
+ * @brief Queue bytes for the console as one unit (not split by log lines)
+ *
+ * Never blocks: the unit is copied to a ring that a low-priority task
+ * drains to the serial port. Call from one task only.
+ *
+ * @param data Bytes to write
+ * @param len Number of bytes, at most HAL_CONSOLE_MAX_WRITE
+ * @return false if the unit was dropped (ring full or too long)
+ */
+bool hal_console_write(const uint8_t *data, size_t len);
+
+#endif // HAL_CONSOLE_H
@@ -0,0 +1,28 @@
+/**
+ * @file hal_gpio.h
+ * @brief Digital outputs
+ */
+
+#ifndef HAL_GPIO_H
+#define HAL_GPIO_H
+
+#include <stdint.h>
+
+/**
+ * @brief Configure pins as push-pull outputs
+ * @param pin_mask Bit n selects GPIOn
+ */
+void hal_gpio_config_outputs(uint64_t pin_mask);
+
+/**
+ * @brief Change several outputs of GPIO0..31 at once
+ *
+ * Pins in clr_mask go low first, then pins in set_mask go high; each step
+ * is a single register write.
+ *
+ * @param set_mask Pins to drive high
+ * @param clr_mask Pins to drive low
+ */
+void hal_gpio_write_masks(uint32_t set_mask, uint32_t clr_mask);
+
+#endif // HAL_GPIO_H
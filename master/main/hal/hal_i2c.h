@@ -0,0 +1,58 @@
+/**
+ * @file hal_i2c.h
+ * @brief I2C master bus (one bus, one device)
+ *
+ * Only one transaction may be in flight. Completion callbacks run in
+ * interrupt context on target and synchronously on the host.
+ */
+
+#ifndef HAL_I2C_H
+#define HAL_I2C_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Bring up the I2C master with internal pull-ups
+ * @param sda SDA pin
+ * @param scl SCL pin
+ * @param freq_hz Bus clock
+ * @return true on success
+ */
+bool hal_i2c_init(int sda, int scl, uint32_t freq_hz);
+
+/**
+ * @brief Transaction completion callback (interrupt context on target)
+ * @param ok true if the device acknowledged everything
+ * @param ctx Context given to hal_i2c_write_async()
+ * @return true if a higher-priority task was woken
+ */
+typedef bool (*hal_i2c_done_cb_t)(bool ok, void *ctx);
+
+/**
+ * @brief Write one transaction to a device and wait for it
+ *
+ * On timeout the bus is drained (or reset) before returning, so a late
+ * completion never reaches a later transaction.
+ *
+ * @param addr 7-bit device address
+ * @param data Bytes to send
+ * @param len Number of bytes
+ * @return true if the device acknowledged everything
+ */
+bool hal_i2c_write(uint8_t addr, const uint8_t *data, size_t len);
+
+/**
+ * @brief Start one transaction and return immediately
+ * @param addr 7-bit device address
+ * @param data Bytes to send (must stay valid until cb runs)
+ * @param len Number of bytes
+ * @param cb Completion callback
+ * @param ctx Passed to cb
+ * @return true if the transaction was started (cb will run)
+ */
+bool hal_i2c_write_async(uint8_t addr, const uint8_t *data, size_t len,
+                         hal_i2c_done_cb_t cb, void *ctx);
+
+#endif // HAL_I2C_H
@@ -0,0 +1,27 @@
+/**
+ * @file hal_log.h
+ * @brief Logging for code that also builds on the host
+ *
+ * On target this is esp_log.h. The host build maps ESP_LOGx to stderr
+ * (debug and verbose levels are dropped).
+ */
+
+#ifndef HAL_LOG_H
+#define HAL_LOG_H
+
+#ifdef ESP_PLATFORM
+#include "esp_log.h"
+#else
+#include <stdio.h>
+
+#define HAL_LOG_HOST(lvl, tag, fmt, ...)                                       \
+  fprintf(stderr, lvl " (%s) " fmt "\n", tag, ##__VA_ARGS__)
+
+#define ESP_LOGE(tag, fmt, ...) HAL_LOG_HOST("E", tag, fmt, ##__VA_ARGS__)
+#define ESP_LOGW(tag, fmt, ...) HAL_LOG_HOST("W", tag, fmt, ##__VA_ARGS__)
+#define ESP_LOGI(tag, fmt, ...) HAL_LOG_HOST("I", tag, fmt, ##__VA_ARGS__)
+#define ESP_LOGD(tag, fmt, ...) ((void)(tag))
+#define ESP_LOGV(tag, fmt, ...) ((void)(tag))
+#endif
+
+#endif // HAL_LOG_H
@@ -0,0 +1,48 @@
+/**
+ * @file hal_queue.h
+ * @brief Fixed-size message queue over caller-provided storage
+ *
+ * Items are copied in and out by value. Sends and receives never block,
+ * and a queue never allocates: the storage is the caller's static array.
+ * Any task may send; one task receives.
+ */
+
+#ifndef HAL_QUEUE_H
+#define HAL_QUEUE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define HAL_QUEUE_MAX 2 // Queues that can exist at once
+
+typedef struct hal_queue hal_queue_t;
+
+/**
+ * @brief Create a queue
+ * @param item_size Bytes per item
+ * @param length Items the queue holds
+ * @param storage length * item_size bytes, valid for the queue's lifetime
+ * @return Queue, or NULL if HAL_QUEUE_MAX queues exist already
+ */
+hal_queue_t *hal_queue_create(size_t item_size, size_t length,
+                              uint8_t *storage);
+
+/**
+ * @brief Append a copy of an item
+ * @return false if the queue is full
+ */
+bool hal_queue_send(hal_queue_t *q, const void *item);
+
+/**
+ * @brief Take the oldest item
+ * @return false if the queue is empty
+ */
+bool hal_queue_receive(hal_queue_t *q, void *item);
+
+/**
+ * @brief Number of items waiting
+ */
+size_t hal_queue_pending(hal_queue_t *q);
+
+#endif // HAL_QUEUE_H
@@ -22,11 +22,16 @@
 #include "buttons.h"
 #include "buzzer.h"
 #include "config.h"
+#include "control.h"
 #include "display.h"
 #include "espnow_handler.h"
+#include "event_bus.h"
 #include "fsm.h"
+#include "link_stats.h"
 #include "motor.h"
 #include "nvs_storage.h"
+#include "scheduler.h"
+#include "telemetry_tx.h"
 #include "types.h"
 
 
@@ -36,9 +41,7 @@ static const char *TAG = "MAIN";
 system_context_t g_ctx = {0};
 
 // Task handles
-static TaskHandle_t s_button_task_handle = NULL;
 static TaskHandle_t s_display_task_handle = NULL;
-static TaskHandle_t s_control_task_handle = NULL;
 
 // ============================================================
 // WIFI INITIALIZATION
@@ -63,68 +66,39 @@ static void wifi_init(void) {
 }
 
 // ============================================================
-// BUTTON POLLING TASK
+// BUTTON RATE GROUP
 // ============================================================
-static void button_task(void *arg) {
-  ESP_LOGI(TAG, "Button task started");
-
-  while (1) {
-    button_event_t evt = buttons_poll();
-    if (evt != BTN_EVT_NONE) {
-      fsm_process_button(evt);
-    }
-    vTaskDelay(pdMS_TO_TICKS(10));
+static void button_group(void) {
+  button_event_t evt = buttons_poll();
+  if (evt != BTN_EVT_NONE) {
+    event_bus_post_button(evt);
   }
 }
 
 // ============================================================
 // DISPLAY UPDATE TASK
 // ============================================================
+// Sole owner of the OLED bus. Woken by the display rate group and by the
+// completion of each asynchronous transfer.
 static void display_task(void *arg) {
   ESP_LOGI(TAG, "Display task started");
 
   while (1) {
-    if (g_ctx.display_dirty) {
-      display_update();
-      g_ctx.display_dirty = false;
-    }
-    vTaskDelay(pdMS_TO_TICKS(DISPLAY_UPDATE_MS));
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    display_service();
   }
 }
 
-// ============================================================
-// CONTROL LOOP TASK
-// ============================================================
-static void control_task(void *arg) {
-  ESP_LOGI(TAG, "Control task started");
-
-  while (1) {
-    // Update FSM (check timeouts)
-    fsm_update();
-
-    // Process control based on current state
-    switch (g_ctx.current_state) {
-    case STATE_MODE_MECANUM:
-    case STATE_MODE_RC:
-      if (g_ctx.joystick_connected) {
-        fsm_process_joystick();
-        motor_apply_speeds(&g_ctx.motor_speeds);
-      }
-      break;
-    case STATE_MODE_VOICE:
-      if (g_ctx.voice_connected) {
-        fsm_process_voice();
-        motor_apply_speeds(&g_ctx.motor_speeds);
-      }
-      break;
-    default:
-      break;
-    }
-
-    vTaskDelay(pdMS_TO_TICKS(20)); // 50Hz control loop
+static bool display_wake_from_isr(void) {
+  BaseType_t woken = pdFALSE;
+  if (s_display_task_handle) {
+    vTaskNotifyGiveFromISR(s_display_task_handle, &woken);
   }
+  return woken == pdTRUE;
 }
 
+static void display_group(void) { xTaskNotifyGive(s_display_task_handle); }
+
 // ============================================================
 // MAIN ENTRY POINT
 // ============================================================
@@ -162,6 +136,9 @@ void app_main(void) {
   motor_init();
   ESP_LOGI(TAG, "Motor control initialized");
 
+  // Event bus must exist before the first producer starts
+  event_bus_init();
+
   // Initialize WiFi and ESP-NOW
   wifi_init();
   espnow_handler_init();
@@ -178,19 +155,56 @@ void app_main(void) {
   // Initial display update
   g_ctx.display_dirty = true;
 
-  // Create tasks
-  xTaskCreate(button_task, "button_task", 2048, NULL, 5, &s_button_task_handle);
+  // Create display task and start the executive (fastest group first)
   xTaskCreate(display_task, "display_task", 4096, NULL, 3,
               &s_display_task_handle);
-  xTaskCreate(control_task, "control_task", 4096, NULL, 4,
-              &s_control_task_handle);
+  display_set_wake_hook(display_wake_from_isr);
+
+  scheduler_init();
+  control_init();
+  scheduler_add_group("buttons", BUTTON_POLL_MS * 1000, button_group);
+  scheduler_add_group("display", DISPLAY_UPDATE_MS * 1000, display_group);
+  telemetry_tx_init();
+  scheduler_start();
 
   ESP_LOGI(TAG, "============================================");
   ESP_LOGI(TAG, "  System Ready");
   ESP_LOGI(TAG, "============================================");
 
-  // Main task can idle or handle other duties
+  // Main task only reports executive timing
   while (1) {
-    vTaskDelay(pdMS_TO_TICKS(1000));
+    vTaskDelay(pdMS_TO_TICKS(SCHED_STATS_LOG_MS));
+    scheduler_log_stats();
+    control_log_stats();
+
+    event_bus_stats_t ev;
+    event_bus_get_stats(&ev);
+    ESP_LOGI(TAG, "Events: posted=%lu dropped=%lu lat(avg/max)=%lu/%lu us",
+             (unsigned long)ev.posted, (unsigned long)ev.dropped,
+             (unsigned long)ev.mean_latency_us,
+             (unsigned long)ev.max_latency_us);
+
+    motor_write_stats_t mw;
+    motor_get_write_stats(&mw);
+    ESP_LOGI(TAG, "Motor writes: performed=%lu skipped=%lu",
+             (unsigned long)mw.performed, (unsigned long)mw.skipped);
+
+    display_flush_stats_t df;
+    display_get_flush_stats(&df);
+    ESP_LOGI(TAG,
+             "Display: frames=%lu bytes last/max/avg=%lu/%lu/%lu "
+             "flush last/max=%lu/%lu us",
+             (unsigned long)df.frames, (unsigned long)df.last_bytes,
+             (unsigned long)df.max_bytes,
+             (unsigned long)(df.frames ? df.total_bytes / df.frames : 0),
+             (unsigned long)df.last_us, (unsigned long)df.max_us);
+
+    espnow_tx_stats_t tx;
+    espnow_handler_get_tx_stats(&tx);
+    ESP_LOGI(TAG, "ESP-NOW TX: queued=%lu dropped=%lu sent=%lu failed=%lu",
+             (unsigned long)tx.queued, (unsigned long)tx.dropped,
+             (unsigned long)tx.sent, (unsigned long)tx.failed);
+
+    link_stats_log();
   }
 }
@@ -0,0 +1,101 @@
+/**
+ * @file drive_shaping.c
+ * @brief Integer (Q15) input shaping and wheel mixing implementation
+ */
+
+#include <stdlib.h>
+
+#include "config.h"
+#include "drive_shaping.h"
+
+// ============================================================
+// SHAPING TABLE (generated by the preprocessor)
+// ============================================================
+// With x = n / D, n = |raw| - DEADZONE, D = 255 - DEADZONE, e = expo / 256:
+//   y = (1 - e) * x + e * x^3, entry = floor(32768 * y), clamped to Q15_ONE
+// evaluated exactly over a common denominator, 0 inside the deadzone.
+#define SHAPE_D (255LL - DEADZONE)
+#define SHAPE_N(r) ((long long)(r) - DEADZONE)
+#define SHAPE_Y_RAW(r)                                                         \
+  ((32768LL * ((256 - SHAPE_EXPO_Q8) * SHAPE_N(r) * SHAPE_D * SHAPE_D +       \
+               SHAPE_EXPO_Q8 * SHAPE_N(r) * SHAPE_N(r) * SHAPE_N(r))) /        \
+   (256LL * SHAPE_D * SHAPE_D * SHAPE_D))
+#define SHAPE_Y(r)                                                             \
+  ((r) < DEADZONE ? 0 : SHAPE_Y_RAW(r) > Q15_ONE ? Q15_ONE : SHAPE_Y_RAW(r))
+
+#define L1(i) (int16_t)SHAPE_Y(i),
+#define L4(i) L1(i) L1((i) + 1) L1((i) + 2) L1((i) + 3)
+#define L16(i) L4(i) L4((i) + 4) L4((i) + 8) L4((i) + 12)
+#define L64(i) L16(i) L16((i) + 16) L16((i) + 32) L16((i) + 48)
+
+static const int16_t s_shape_lut[256] = {L64(0) L64(64) L64(128) L64(192)};
+
+// ============================================================
+// AXIS SHAPING
+// ============================================================
+int16_t shaping_axis(int16_t raw) {
+  int mag = abs(raw);
+  if (mag > 255)
+    mag = 255;
+
+  int16_t y = s_shape_lut[mag];
+  return (raw < 0) ? -y : y;
+}
+
+// ============================================================
+// Q15 -> DUTY
+// ============================================================
+// duty = round(|w| * MAX_SPEED / fs), half away from zero, where the full
+// scale fs is 2^15, or the largest wheel demand when one exceeds it (all
+// wheels then shrink by the same factor). Divides only when desaturating.
+static void to_duties(const int32_t w[4], int16_t duty[4]) {
+  int32_t peak = 0;
+  for (int i = 0; i < 4; i++) {
+    if (abs(w[i]) > peak)
+      peak = abs(w[i]);
+  }
+
+  for (int i = 0; i < 4; i++) {
+    int32_t m = (peak <= 32768)
+                    ? (abs(w[i]) * MAX_SPEED + (1 << 14)) >> 15
+                    : (2 * abs(w[i]) * MAX_SPEED + peak) / (2 * peak);
+    duty[i] = (int16_t)((w[i] < 0) ? -m : m);
+  }
+}
+
+// ============================================================
+// MIXERS
+// ============================================================
+void shaping_mix_mecanum(int16_t vy, int16_t vx, int16_t omega,
+                         motor_speeds_t *speeds) {
+  int32_t w[4] = {
+      vy + vx + omega, // FL
+      vy - vx - omega, // FR
+      vy - vx + omega, // BL
+      vy + vx - omega, // BR
+  };
+  int16_t duty[4];
+  to_duties(w, duty);
+
+  speeds->fl = duty[0];
+  speeds->fr = duty[1];
+  speeds->bl = duty[2];
+  speeds->br = duty[3];
+}
+
+void shaping_mix_differential(int16_t throttle, int16_t steering,
+                              motor_speeds_t *speeds) {
+  int32_t w[4] = {
+      throttle + steering, // Left
+      throttle - steering, // Right
+      0,
+      0,
+  };
+  int16_t duty[4];
+  to_duties(w, duty);
+
+  speeds->fl = duty[0];
+  speeds->bl = duty[0];
+  speeds->fr = duty[1];
+  speeds->br = duty[1];
+}
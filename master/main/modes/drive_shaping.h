@@ -0,0 +1,50 @@
+/**
+ * @file drive_shaping.h
+ * @brief Integer (Q15) input shaping and wheel mixing for the drive modes
+ *
+ * Stick values (-255..255) are shaped through a table built at compile
+ * time: values inside DEADZONE become 0, the remaining travel is rescaled
+ * to the full Q15 range, and an expo curve (SHAPE_EXPO_Q8) softens the
+ * centre. Mixers work on Q15 and return wheel duties in -MAX_SPEED..
+ * MAX_SPEED. No floating point; 32-bit divisions only while desaturating.
+ *
+ * Both stages are bit-exact with the float formulas documented in
+ * drive_shaping.c (checked over the whole stick grid by the host test).
+ */
+
+#ifndef DRIVE_SHAPING_H
+#define DRIVE_SHAPING_H
+
+#include <stdint.h>
+
+#include "types.h"
+
+#define Q15_ONE 32767
+
+/**
+ * @brief Shape one stick axis
+ * @param raw Stick value -255..255 (clamped)
+ * @return Shaped value in Q15 (-Q15_ONE..Q15_ONE)
+ */
+int16_t shaping_axis(int16_t raw);
+
+/**
+ * @brief Mecanum inverse kinematics with proportional desaturation
+ * @param vy Forward velocity (Q15)
+ * @param vx Right strafe velocity (Q15)
+ * @param omega Clockwise turn rate (Q15)
+ * @param speeds Output wheel duties
+ */
+void shaping_mix_mecanum(int16_t vy, int16_t vx, int16_t omega,
+                         motor_speeds_t *speeds);
+
+/**
+ * @brief Differential (tank) mixing with proportional desaturation
+ * @param throttle Forward velocity (Q15)
+ * @param steering Right turn (Q15)
+ * @param speeds Output wheel duties (left = FL/BL, right = FR/BR)
+ */
+void shaping_mix_differential(int16_t throttle, int16_t steering,
+                              motor_speeds_t *speeds);
+
+#endif // DRIVE_SHAPING_H
@@ -2,30 +2,43 @@
  * @file mode_mecanum.c
  * @brief Mecanum drive mode implementation
  *
- * Movement mapping for Mecanum wheels:
- *   FORWARD:      All motors forward
- *   BACKWARD:     All motors backward
- *   STRAFE LEFT:  FL+BR backward, FR+BL forward
- *   STRAFE RIGHT: FL+BR forward, FR+BL backward
- *   ROTATE LEFT:  FL+BL backward, FR+BR forward
- *   ROTATE RIGHT: FL+BL forward, FR+BR backward
+ * Continuous inverse kinematics on shaped Q15 inputs (drive_shaping.c).
+ * The main stick gives the body velocity (throttle = vy forward, steering =
+ * vx right), the aux stick X axis gives the turn rate (omega, clockwise
+ * positive):
+ *
+ *   FL = vy + vx + omega
+ *   FR = vy - vx - omega
+ *   BL = vy - vx + omega
+ *   BR = vy + vx - omega
+ *
+ * Any mix is possible: diagonal strafe, or translating while rotating.
+ * When a wheel would exceed MAX_SPEED all four are scaled down by the same
+ * factor, which keeps the direction of motion. movement_type_t is only a
+ * label for the UI, taken from the dominant component.
  */
 
-#include "esp_log.h"
 #include <stdlib.h>
 
 
 #include "buzzer.h"
 #include "config.h"
+#include "drive_shaping.h"
 #include "fsm.h"
+#include "hal_log.h"
 #include "mode_mecanum.h"
 #include "motor.h"
 #include "types.h"
 #include "ui_common.h"
+#include "ui_telemetry.h"
+#include "ui_widgets.h"
 
 
 static const char *TAG = "MECANUM";
 
+// UP/DOWN swap the drive screen for the telemetry page
+static bool s_telemetry = false;
+
 // ============================================================
 // BUTTON HANDLER
 // ============================================================
@@ -41,168 +54,117 @@ void mode_mecanum_handle_button(button_event_t evt) {
     // Emergency stop
     motor_stop_all();
     g_ctx.movement = MOVEMENT_EMERGENCY;
+    fsm_estop_latch();
     g_ctx.display_dirty = true;
     buzzer_error();
     break;
 
+  case BTN_EVT_UP_PRESSED:
+  case BTN_EVT_DOWN_PRESSED:
+    s_telemetry = !s_telemetry;
+    g_ctx.display_dirty = true;
+    break;
+
   default:
     break;
   }
 }
 
 // ============================================================
-// INTERPRET JOYSTICK FOR MECANUM
+// CLASSIFY MOVEMENT (UI label only)
 // ============================================================
-static movement_type_t interpret_mecanum(int16_t throttle, int16_t steering) {
-  // Apply deadzone
-  if (abs(throttle) < DEADZONE)
-    throttle = 0;
-  if (abs(steering) < DEADZONE)
-    steering = 0;
-
-  // Emergency button check
-  if (g_ctx.joystick.btn1) {
-    return MOVEMENT_EMERGENCY;
-  }
-
-  // No input
-  if (throttle == 0 && steering == 0) {
+static movement_type_t classify_mecanum(int16_t vy, int16_t vx,
+                                        int16_t omega) {
+  if (vy == 0 && vx == 0 && omega == 0) {
     return MOVEMENT_STOP;
   }
 
-  // Check for strafe (horizontal movement only)
-  if (abs(throttle) < DEADZONE && abs(steering) > DEADZONE) {
-    return (steering > 0) ? MOVEMENT_STRAFE_RIGHT : MOVEMENT_STRAFE_LEFT;
-  }
+  int ay = abs(vy), ax = abs(vx), aw = abs(omega);
 
-  // Check for rotation vs forward/backward
-  float ratio = (float)abs(steering) / (float)(abs(throttle) + 1);
-
-  if (abs(throttle) > DEADZONE) {
-    if (ratio > DIAGONAL_RATIO) {
-      // Rotation mode
-      return (steering > 0) ? MOVEMENT_ROTATE_RIGHT : MOVEMENT_ROTATE_LEFT;
-    } else {
-      // Forward/backward
-      return (throttle > 0) ? MOVEMENT_FORWARD : MOVEMENT_BACKWARD;
-    }
+  if (aw >= ay && aw >= ax) {
+    return (omega > 0) ? MOVEMENT_ROTATE_RIGHT : MOVEMENT_ROTATE_LEFT;
   }
-
-  return MOVEMENT_STOP;
-}
-
-// ============================================================
-// CALCULATE MOTOR SPEEDS FOR MECANUM
-// ============================================================
-static void calculate_mecanum_speeds(int16_t throttle, int16_t steering,
-                                     motor_speeds_t *speeds) {
-  // Apply deadzone
-  if (abs(throttle) < DEADZONE)
-    throttle = 0;
-  if (abs(steering) < DEADZONE)
-    steering = 0;
-
-  // Calculate base speed
-  int16_t speed = abs(throttle);
-  if (speed == 0)
-    speed = abs(steering);
-  if (speed > MAX_SPEED)
-    speed = MAX_SPEED;
-
-  switch (g_ctx.movement) {
-  case MOVEMENT_FORWARD:
-    speeds->fl = speed;
-    speeds->fr = speed;
-    speeds->bl = speed;
-    speeds->br = speed;
-    break;
-
-  case MOVEMENT_BACKWARD:
-    speeds->fl = -speed;
-    speeds->fr = -speed;
-    speeds->bl = -speed;
-    speeds->br = -speed;
-    break;
-
-  case MOVEMENT_STRAFE_LEFT:
-    speeds->fl = -speed;
-    speeds->fr = speed;
-    speeds->bl = speed;
-    speeds->br = -speed;
-    break;
-
-  case MOVEMENT_STRAFE_RIGHT:
-    speeds->fl = speed;
-    speeds->fr = -speed;
-    speeds->bl = -speed;
-    speeds->br = speed;
-    break;
-
-  case MOVEMENT_ROTATE_LEFT:
-    speeds->fl = -speed;
-    speeds->fr = speed;
-    speeds->bl = -speed;
-    speeds->br = speed;
-    break;
-
-  case MOVEMENT_ROTATE_RIGHT:
-    speeds->fl = speed;
-    speeds->fr = -speed;
-    speeds->bl = speed;
-    speeds->br = -speed;
-    break;
-
-  case MOVEMENT_STOP:
-  case MOVEMENT_EMERGENCY:
-  default:
-    speeds->fl = 0;
-    speeds->fr = 0;
-    speeds->bl = 0;
-    speeds->br = 0;
-    break;
+  if (ax > ay) {
+    return (vx > 0) ? MOVEMENT_STRAFE_RIGHT : MOVEMENT_STRAFE_LEFT;
   }
+  return (vy > 0) ? MOVEMENT_FORWARD : MOVEMENT_BACKWARD;
 }
 
 // ============================================================
 // PROCESS
 // ============================================================
 void mode_mecanum_process(void) {
-  // Interpret joystick
-  movement_type_t new_movement =
-      interpret_mecanum(g_ctx.joystick.throttle, g_ctx.joystick.steering);
+  int16_t vy = shaping_axis(g_ctx.joystick.throttle);
+  int16_t vx = shaping_axis(g_ctx.joystick.steering);
+  int16_t omega = shaping_axis(g_ctx.joystick.aux_x);
+
+  movement_type_t new_movement = fsm_estop_gate(
+      g_ctx.joystick.btn1 ? MOVEMENT_EMERGENCY
+                          : classify_mecanum(vy, vx, omega));
 
   // Check for movement change
   if (new_movement != g_ctx.movement) {
     g_ctx.movement = new_movement;
-    g_ctx.display_dirty = true;
     ESP_LOGI(TAG, "Movement: %d", new_movement);
   }
 
-  // Calculate motor speeds
-  calculate_mecanum_speeds(g_ctx.joystick.throttle, g_ctx.joystick.steering,
-                           &g_ctx.motor_speeds);
+  if (new_movement == MOVEMENT_EMERGENCY) {
+    g_ctx.motor_speeds = (motor_speeds_t){0, 0, 0, 0};
+    return;
+  }
+
+  shaping_mix_mecanum(vy, vx, omega, &g_ctx.motor_speeds);
 }
 
+// ============================================================
+// EXIT
+// ============================================================
+void mode_mecanum_exit(void) { s_telemetry = false; }
+
 // ============================================================
 // DRAW
 // ============================================================
+static ui_widget_t s_w_movement, s_w_throttle, s_w_steering, s_w_status;
+// Status first: it is the only widget while waiting for the joystick
+static ui_widget_t *const s_widgets[] = {&s_w_status, &s_w_movement,
+                                         &s_w_throttle, &s_w_steering};
+static bool s_live = false; // Widgets on screen (joystick connected)
+
+static int update_widgets(void) {
+  ui_widget_set(&s_w_movement, g_ctx.movement);
+  ui_widget_set(&s_w_throttle, g_ctx.joystick.throttle);
+  ui_widget_set(&s_w_steering, g_ctx.joystick.steering);
+  ui_widget_set(&s_w_status, ui_status_bits());
+  return ui_widgets_render(s_widgets, s_live ? 4 : 1);
+}
+
 void mode_mecanum_draw(void) {
+  if (s_telemetry) {
+    ui_telemetry_draw();
+    return;
+  }
+
   ui_draw_header("MECANUM");
 
-  // Connection status
-  if (!g_ctx.joystick_connected) {
+  ui_widget_init_movement(&s_w_movement);
+  ui_widget_init_value(&s_w_throttle, 10, 45, "T:%4d", 6);
+  ui_widget_init_value(&s_w_steering, 52, 45, "S:%4d", 6);
+  ui_widget_init_status(&s_w_status);
+
+  s_live = g_ctx.joystick_connected;
+  if (!s_live) {
     display_draw_string(15, 25, "Waiting for");
     display_draw_string(25, 35, "Joystick...");
-  } else {
-    // Show movement
-    ui_draw_movement(g_ctx.movement);
-
-    // Show joystick values
-    char buf[32];
-    snprintf(buf, sizeof(buf), "T:%4d S:%4d", g_ctx.joystick.throttle,
-             g_ctx.joystick.steering);
-    display_draw_string(10, 45, buf);
   }
+  update_widgets();
+}
 
-  ui_draw_status_bar();
+bool mode_mecanum_refresh(void) {
+  if (s_telemetry) {
+    return ui_telemetry_refresh();
+  }
+  if (s_live != g_ctx.joystick_connected) {
+    return false; // Layout change, waits for a full redraw
+  }
+  return update_widgets() > 0;
 }
@@ -9,21 +9,27 @@
  *   TURN RIGHT: Right motors slower/reverse, left motors forward
  */
 
-#include "esp_log.h"
 #include <stdlib.h>
 
 
 #include "buzzer.h"
 #include "config.h"
+#include "drive_shaping.h"
 #include "fsm.h"
+#include "hal_log.h"
 #include "mode_rc.h"
 #include "motor.h"
 #include "types.h"
 #include "ui_common.h"
+#include "ui_telemetry.h"
+#include "ui_widgets.h"
 
 
 static const char *TAG = "RC";
 
+// UP/DOWN swap the drive screen for the telemetry page
+static bool s_telemetry = false;
+
 // ============================================================
 // BUTTON HANDLER
 // ============================================================
@@ -37,10 +43,17 @@ void mode_rc_handle_button(button_event_t evt) {
   case BTN_EVT_OK_LONG:
     motor_stop_all();
     g_ctx.movement = MOVEMENT_EMERGENCY;
+    fsm_estop_latch();
     g_ctx.display_dirty = true;
     buzzer_error();
     break;
 
+  case BTN_EVT_UP_PRESSED:
+  case BTN_EVT_DOWN_PRESSED:
+    s_telemetry = !s_telemetry;
+    g_ctx.display_dirty = true;
+    break;
+
   default:
     break;
   }
@@ -49,12 +62,8 @@ void mode_rc_handle_button(button_event_t evt) {
 // ============================================================
 // INTERPRET JOYSTICK FOR RC
 // ============================================================
+// Inputs are shaped (Q15): anything inside the deadzone is already 0.
 static movement_type_t interpret_rc(int16_t throttle, int16_t steering) {
-  if (abs(throttle) < DEADZONE)
-    throttle = 0;
-  if (abs(steering) < DEADZONE)
-    steering = 0;
-
   if (g_ctx.joystick.btn1) {
     return MOVEMENT_EMERGENCY;
   }
@@ -64,8 +73,8 @@ static movement_type_t interpret_rc(int16_t throttle, int16_t steering) {
   }
 
   // RC mode: throttle controls speed, steering controls direction
-  if (abs(throttle) > DEADZONE) {
-    if (abs(steering) > DEADZONE) {
+  if (throttle != 0) {
+    if (steering != 0) {
       // Turning while moving
       if (throttle > 0) {
         return (steering > 0) ? MOVEMENT_TURN_RIGHT : MOVEMENT_TURN_LEFT;
@@ -79,86 +88,83 @@ static movement_type_t interpret_rc(int16_t throttle, int16_t steering) {
   }
 
   // Steering without throttle: rotate in place
-  if (abs(steering) > DEADZONE) {
-    return (steering > 0) ? MOVEMENT_ROTATE_RIGHT : MOVEMENT_ROTATE_LEFT;
-  }
-
-  return MOVEMENT_STOP;
-}
-
-// ============================================================
-// CALCULATE MOTOR SPEEDS FOR RC (DIFFERENTIAL DRIVE)
-// ============================================================
-static void calculate_rc_speeds(int16_t throttle, int16_t steering,
-                                motor_speeds_t *speeds) {
-  if (abs(throttle) < DEADZONE)
-    throttle = 0;
-  if (abs(steering) < DEADZONE)
-    steering = 0;
-
-  // Tank/differential mixing
-  int16_t left_speed = throttle + steering;
-  int16_t right_speed = throttle - steering;
-
-  // Clamp speeds
-  if (left_speed > MAX_SPEED)
-    left_speed = MAX_SPEED;
-  if (left_speed < -MAX_SPEED)
-    left_speed = -MAX_SPEED;
-  if (right_speed > MAX_SPEED)
-    right_speed = MAX_SPEED;
-  if (right_speed < -MAX_SPEED)
-    right_speed = -MAX_SPEED;
-
-  // Apply to all 4 motors (left side = FL+BL, right side = FR+BR)
-  speeds->fl = left_speed;
-  speeds->bl = left_speed;
-  speeds->fr = right_speed;
-  speeds->br = right_speed;
-
-  // Emergency stop
-  if (g_ctx.movement == MOVEMENT_EMERGENCY) {
-    speeds->fl = 0;
-    speeds->fr = 0;
-    speeds->bl = 0;
-    speeds->br = 0;
-  }
+  return (steering > 0) ? MOVEMENT_ROTATE_RIGHT : MOVEMENT_ROTATE_LEFT;
 }
 
 // ============================================================
 // PROCESS
 // ============================================================
 void mode_rc_process(void) {
+  int16_t throttle = shaping_axis(g_ctx.joystick.throttle);
+  int16_t steering = shaping_axis(g_ctx.joystick.steering);
+
   movement_type_t new_movement =
-      interpret_rc(g_ctx.joystick.throttle, g_ctx.joystick.steering);
+      fsm_estop_gate(interpret_rc(throttle, steering));
 
   if (new_movement != g_ctx.movement) {
     g_ctx.movement = new_movement;
-    g_ctx.display_dirty = true;
     ESP_LOGI(TAG, "Movement: %d", new_movement);
   }
 
-  calculate_rc_speeds(g_ctx.joystick.throttle, g_ctx.joystick.steering,
-                      &g_ctx.motor_speeds);
+  // Emergency stop
+  if (new_movement == MOVEMENT_EMERGENCY) {
+    g_ctx.motor_speeds = (motor_speeds_t){0, 0, 0, 0};
+    return;
+  }
+
+  // Tank/differential mixing (left side = FL+BL, right side = FR+BR)
+  shaping_mix_differential(throttle, steering, &g_ctx.motor_speeds);
 }
 
+// ============================================================
+// EXIT
+// ============================================================
+void mode_rc_exit(void) { s_telemetry = false; }
+
 // ============================================================
 // DRAW
 // ============================================================
+static ui_widget_t s_w_movement, s_w_throttle, s_w_steering, s_w_status;
+// Status first: it is the only widget while waiting for the joystick
+static ui_widget_t *const s_widgets[] = {&s_w_status, &s_w_movement,
+                                         &s_w_throttle, &s_w_steering};
+static bool s_live = false; // Widgets on screen (joystick connected)
+
+static int update_widgets(void) {
+  ui_widget_set(&s_w_movement, g_ctx.movement);
+  ui_widget_set(&s_w_throttle, g_ctx.joystick.throttle);
+  ui_widget_set(&s_w_steering, g_ctx.joystick.steering);
+  ui_widget_set(&s_w_status, ui_status_bits());
+  return ui_widgets_render(s_widgets, s_live ? 4 : 1);
+}
+
 void mode_rc_draw(void) {
+  if (s_telemetry) {
+    ui_telemetry_draw();
+    return;
+  }
+
   ui_draw_header("RC MODE");
 
-  if (!g_ctx.joystick_connected) {
+  ui_widget_init_movement(&s_w_movement);
+  ui_widget_init_value(&s_w_throttle, 10, 45, "T:%4d", 6);
+  ui_widget_init_value(&s_w_steering, 52, 45, "S:%4d", 6);
+  ui_widget_init_status(&s_w_status);
+
+  s_live = g_ctx.joystick_connected;
+  if (!s_live) {
     display_draw_string(15, 25, "Waiting for");
     display_draw_string(25, 35, "Joystick...");
-  } else {
-    ui_draw_movement(g_ctx.movement);
-
-    char buf[32];
-    snprintf(buf, sizeof(buf), "T:%4d S:%4d", g_ctx.joystick.throttle,
-             g_ctx.joystick.steering);
-    display_draw_string(10, 45, buf);
   }
+  update_widgets();
+}
 
-  ui_draw_status_bar();
+bool mode_rc_refresh(void) {
+  if (s_telemetry) {
+    return ui_telemetry_refresh();
+  }
+  if (s_live != g_ctx.joystick_connected) {
+    return false; // Layout change, waits for a full redraw
+  }
+  return update_widgets() > 0;
 }
@@ -12,4 +12,15 @@ void mode_rc_handle_button(button_event_t evt);
 void mode_rc_process(void);
 void mode_rc_draw(void);
 
+/**
+ * @brief Leave the mode: the next entry starts on the drive screen
+ */
+void mode_rc_exit(void);
+
+/**
+ * @brief Redraw only the widgets whose values changed since the last frame
+ * @return true if anything was drawn
+ */
+bool mode_rc_refresh(void);
+
 #endif // MODE_RC_H
@@ -3,23 +3,19 @@
  * @brief Settings menu mode implementation
  */
 
-#include "esp_log.h"
 #include <stdio.h>
 
-
 #include "buzzer.h"
 #include "config.h"
 #include "display.h"
 #include "fsm.h"
 #include "mode_settings.h"
 #include "motor.h"
+#include "motor_ramp.h"
 #include "nvs_storage.h"
 #include "types.h"
 #include "ui_common.h"
 
-
-static const char *TAG = "SETTINGS";
-
 #define SETTINGS_ITEMS 5
 
 static const char *s_settings_items[] = {
@@ -70,6 +66,7 @@ static void handle_main_menu(button_event_t evt) {
       motor_set_calibration(
           g_ctx.settings.motor_cal_fl, g_ctx.settings.motor_cal_fr,
           g_ctx.settings.motor_cal_bl, g_ctx.settings.motor_cal_br);
+      motor_ramp_configure(&g_ctx.settings);
       display_set_brightness(g_ctx.settings.brightness);
       buzzer_set_volume(g_ctx.settings.volume);
       fsm_change_state(STATE_MAIN_MENU);
@@ -10,11 +10,11 @@
  *   0x04 = RIGHT (turn)
  */
 
-#include "esp_log.h"
 
 #include "buzzer.h"
 #include "config.h"
 #include "fsm.h"
+#include "hal_log.h"
 #include "mode_voice.h"
 #include "motor.h"
 #include "types.h"
@@ -36,6 +36,7 @@ void mode_voice_handle_button(button_event_t evt) {
   case BTN_EVT_OK_LONG:
     motor_stop_all();
     g_ctx.movement = MOVEMENT_EMERGENCY;
+    fsm_estop_latch();
     g_ctx.display_dirty = true;
     buzzer_error();
     break;
@@ -72,6 +73,7 @@ void mode_voice_process(void) {
     new_movement = MOVEMENT_STOP;
     break;
   }
+  new_movement = fsm_estop_gate(new_movement);
 
   if (new_movement != g_ctx.movement) {
     g_ctx.movement = new_movement;
@@ -154,7 +156,7 @@ void mode_voice_draw(void) {
     display_draw_string(30, 18, "Command:");
 
     const char *cmd_str = get_voice_cmd_str(g_ctx.voice_cmd);
-    int x = (OLED_WIDTH - strlen(cmd_str) * 6) / 2;
+    int x = (OLED_WIDTH - display_text_width(cmd_str, &font_5x7)) / 2;
     display_draw_string(x, 30, cmd_str);
 
     // Show speed
@@ -0,0 +1,75 @@
+/**
+ * @file latency_hist.c
+ * @brief Fixed-size logarithmic latency histogram implementation
+ */
+
+#include <string.h>
+
+#include "latency_hist.h"
+
+#define SUB (1u << LATENCY_HIST_SUB_BITS)
+
+// ============================================================
+// BUCKET MAPPING
+// ============================================================
+// Values below 2*SUB map 1:1; above that, bucket = octave * SUB + the
+// LATENCY_HIST_SUB_BITS bits following the leading one.
+static int bucket_of(uint32_t v) {
+  if (v < 2 * SUB) {
+    return (int)v;
+  }
+
+  int msb = 31 - __builtin_clz(v);
+  int shift = msb - LATENCY_HIST_SUB_BITS;
+  int idx = (shift + 1) * SUB + (int)((v >> shift) & (SUB - 1));
+  return (idx < LATENCY_HIST_BUCKETS) ? idx : LATENCY_HIST_BUCKETS - 1;
+}
+
+static uint32_t bucket_upper(int idx) {
+  if (idx < (int)(2 * SUB)) {
+    return (uint32_t)idx;
+  }
+
+  int shift = idx / SUB - 1;
+  uint32_t mant = SUB + (uint32_t)(idx % SUB);
+  return ((mant + 1) << shift) - 1;
+}
+
+// ============================================================
+// PUBLIC API
+// ============================================================
+void latency_hist_reset(latency_hist_t *h) { memset(h, 0, sizeof(*h)); }
+
+void latency_hist_record(latency_hist_t *h, uint32_t us) {
+  h->buckets[bucket_of(us)]++;
+  h->count++;
+  h->sum_us += us;
+  if (us > h->max_us) {
+    h->max_us = us;
+  }
+}
+
+uint32_t latency_hist_percentile(const latency_hist_t *h, uint8_t pct) {
+  if (h->count == 0) {
+    return 0;
+  }
+
+  uint64_t target = ((uint64_t)h->count * pct + 99) / 100;
+  if (target == 0) {
+    target = 1;
+  }
+
+  uint64_t seen = 0;
+  for (int i = 0; i < LATENCY_HIST_BUCKETS; i++) {
+    seen += h->buckets[i];
+    if (seen >= target) {
+      uint32_t upper = bucket_upper(i);
+      return (upper < h->max_us) ? upper : h->max_us;
+    }
+  }
+  return h->max_us;
+}
+
+uint32_t latency_hist_mean(const latency_hist_t *h) {
+  return h->count ? (uint32_t)(h->sum_us / h->count) : 0;
+}
@@ -0,0 +1,53 @@
+/**
+ * @file latency_hist.h
+ * @brief Fixed-size logarithmic latency histogram
+ *
+ * Buckets split every power of two into four, so any recorded value is
+ * reported within about 20% without storing samples. Recording is O(1)
+ * and allocation-free; one writer, readers tolerate a stale view.
+ */
+
+#ifndef LATENCY_HIST_H
+#define LATENCY_HIST_H
+
+#include <stdint.h>
+
+#define LATENCY_HIST_SUB_BITS 2
+#define LATENCY_HIST_BUCKETS 88 // Covers 0 .. 2^23 us (~8 s)
+
+typedef struct {
+  uint32_t buckets[LATENCY_HIST_BUCKETS];
+  uint32_t count;
+  uint32_t max_us;
+  uint64_t sum_us;
+} latency_hist_t;
+
+/**
+ * @brief Clear histogram
+ * @param h Histogram
+ */
+void latency_hist_reset(latency_hist_t *h);
+
+/**
+ * @brief Record one sample
+ * @param h Histogram
+ * @param us Latency in microseconds
+ */
+void latency_hist_record(latency_hist_t *h, uint32_t us);
+
+/**
+ * @brief Estimate a percentile
+ * @param h Histogram
+ * @param pct Percentile 0-100
+ * @return Upper bound of the bucket holding the percentile, in us
+ */
+uint32_t latency_hist_percentile(const latency_hist_t *h, uint8_t pct);
+
+/**
+ * @brief Mean of all samples
+ * @param h Histogram
+ * @return Mean latency in microseconds
+ */
+uint32_t latency_hist_mean(const latency_hist_t *h);
+
+#endif // LATENCY_HIST_H
@@ -0,0 +1,198 @@
+/**
+ * @file sched_core.c
+ * @brief Platform-independent rate-group scheduler core implementation
+ */
+
+#include <string.h>
+
+#include "sched_core.h"
+
+// ============================================================
+// INITIALIZATION
+// ============================================================
+void sched_core_init(sched_core_t *core, sched_clock_t clock_us) {
+  memset(core, 0, sizeof(*core));
+  core->clock_us = clock_us;
+}
+
+int sched_core_add_group(sched_core_t *core, const char *name,
+                         uint32_t period_us, sched_fn_t fn) {
+  if (core->count >= SCHED_MAX_GROUPS || period_us == 0 || !fn) {
+    return -1;
+  }
+
+  sched_group_t *g = &core->groups[core->count];
+  memset(g, 0, sizeof(*g));
+  g->name = name;
+  g->period_us = period_us;
+  g->fn = fn;
+
+  return core->count++;
+}
+
+void sched_core_start(sched_core_t *core, uint64_t now_us) {
+  for (int i = 0; i < core->count; i++) {
+    core->groups[i].next_release_us = now_us;
+  }
+}
+
+// ============================================================
+// TRIGGERING
+// ============================================================
+void sched_core_set_trigger(sched_core_t *core, int idx, uint32_t min_gap_us) {
+  if (idx >= 0 && idx < core->count) {
+    core->groups[idx].min_gap_us = min_gap_us;
+  }
+}
+
+void sched_core_trigger(sched_core_t *core, int idx) {
+  if (idx >= 0 && idx < core->count && core->groups[idx].min_gap_us) {
+    core->groups[idx].trigger_pending = true;
+  }
+}
+
+uint64_t sched_core_next_trigger(const sched_core_t *core) {
+  uint64_t next = UINT64_MAX;
+  for (int i = 0; i < core->count; i++) {
+    const sched_group_t *g = &core->groups[i];
+    if (g->trigger_pending && g->last_start_us + g->min_gap_us < next) {
+      next = g->last_start_us + g->min_gap_us;
+    }
+  }
+  return next;
+}
+
+// ============================================================
+// RUN DUE GROUPS
+// ============================================================
+static uint64_t execute(sched_core_t *core, sched_group_t *g,
+                        uint64_t now_us) {
+  g->trigger_pending = false;
+  g->last_start_us = now_us;
+  g->fn();
+  uint64_t done = core->clock_us();
+
+  uint32_t exec = (uint32_t)(done - now_us);
+  g->last_exec_us = exec;
+  if (exec > g->max_exec_us)
+    g->max_exec_us = exec;
+  return done;
+}
+
+static void run_triggered(sched_core_t *core, sched_group_t *g,
+                          uint64_t now_us) {
+  execute(core, g, now_us);
+  g->triggered_runs++;
+}
+
+static void run_group(sched_core_t *core, sched_group_t *g, uint64_t now_us) {
+  uint64_t release = g->next_release_us;
+
+  // Releases that passed entirely without running are lost, not queued:
+  // replaying them back-to-back would only make the next one late too.
+  uint64_t late = now_us - release;
+  if (late >= g->period_us) {
+    uint32_t skipped = (uint32_t)(late / g->period_us);
+    g->deadline_misses += skipped;
+    release += (uint64_t)skipped * g->period_us;
+  }
+
+  uint32_t jitter = (uint32_t)(now_us - release);
+  uint64_t done = execute(core, g, now_us);
+  if (done > release + g->period_us) {
+    g->deadline_misses++;
+  }
+
+  g->runs++;
+  g->last_jitter_us = jitter;
+  g->jitter_sum_us += jitter;
+  if (jitter > g->max_jitter_us)
+    g->max_jitter_us = jitter;
+
+  // Next release is anchored to the schedule, not to when we ran
+  g->next_release_us = release + g->period_us;
+}
+
+uint64_t sched_core_run_due(sched_core_t *core, uint64_t now_us) {
+  uint64_t next = UINT64_MAX;
+
+  for (int i = 0; i < core->count; i++) {
+    sched_group_t *g = &core->groups[i];
+    if (now_us >= g->next_release_us) {
+      run_group(core, g, now_us);
+      // Later groups start after this one finished
+      now_us = core->clock_us();
+    } else if (g->trigger_pending) {
+      uint64_t earliest = g->last_start_us + g->min_gap_us;
+      if (now_us >= earliest) {
+        run_triggered(core, g, now_us);
+        now_us = core->clock_us();
+      } else if (earliest < next) {
+        next = earliest;
+      }
+    }
+    if (g->next_release_us < next) {
+      next = g->next_release_us;
+    }
+  }
+
+  return next;
+}
+
+// ============================================================
+// BASE PERIOD
+// ============================================================
+static uint32_t gcd_u32(uint32_t a, uint32_t b) {
+  while (b) {
+    uint32_t t = a % b;
+    a = b;
+    b = t;
+  }
+  return a;
+}
+
+uint32_t sched_core_base_period(const sched_core_t *core) {
+  uint32_t base = 0;
+  for (int i = 0; i < core->count; i++) {
+    base = gcd_u32(core->groups[i].period_us, base);
+  }
+  return base;
+}
+
+// ============================================================
+// STATISTICS
+// ============================================================
+bool sched_core_get_stats(const sched_core_t *core, int idx,
+                          sched_stats_t *out) {
+  if (idx < 0 || idx >= core->count) {
+    return false;
+  }
+
+  const sched_group_t *g = &core->groups[idx];
+  out->name = g->name;
+  out->period_us = g->period_us;
+  out->runs = g->runs;
+  out->triggered_runs = g->triggered_runs;
+  out->deadline_misses = g->deadline_misses;
+  out->last_jitter_us = g->last_jitter_us;
+  out->max_jitter_us = g->max_jitter_us;
+  out->mean_jitter_us =
+      g->runs ? (uint32_t)(g->jitter_sum_us / g->runs) : 0;
+  out->last_exec_us = g->last_exec_us;
+  out->max_exec_us = g->max_exec_us;
+  return true;
+}
+
+void sched_core_reset_stats(sched_core_t *core) {
+  for (int i = 0; i < core->count; i++) {
+    sched_group_t *g = &core->groups[i];
+    g->runs = 0;
+    g->triggered_runs = 0;
+    g->deadline_misses = 0;
+    g->last_jitter_us = 0;
+    g->max_jitter_us = 0;
+    g->jitter_sum_us = 0;
+    g->last_exec_us = 0;
+    g->max_exec_us = 0;
+  }
+}
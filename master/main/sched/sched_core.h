@@ -0,0 +1,154 @@
+/**
+ * @file sched_core.h
+ * @brief Platform-independent rate-group scheduler core
+ *
+ * The core owns release times and timing statistics for a fixed set of
+ * rate groups. It never sleeps and never reads a hardware clock directly:
+ * the caller passes the current time in and gets the next release time
+ * back, so the same code runs under FreeRTOS and on a host with a
+ * simulated clock.
+ */
+
+#ifndef SCHED_CORE_H
+#define SCHED_CORE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define SCHED_MAX_GROUPS 6
+
+typedef void (*sched_fn_t)(void);
+typedef uint64_t (*sched_clock_t)(void);
+
+/**
+ * @brief Timing statistics of one rate group
+ */
+typedef struct {
+  const char *name;
+  uint32_t period_us;
+  uint32_t runs;            // Completed periodic releases
+  uint32_t triggered_runs;  // Out-of-schedule runs (sched_core_trigger)
+  uint32_t deadline_misses; // Overruns + skipped releases
+  uint32_t last_jitter_us;  // Start time - release time, last run
+  uint32_t max_jitter_us;
+  uint32_t mean_jitter_us;
+  uint32_t last_exec_us;
+  uint32_t max_exec_us;
+} sched_stats_t;
+
+typedef struct {
+  const char *name;
+  uint32_t period_us;
+  sched_fn_t fn;
+  uint64_t next_release_us;
+
+  // Input triggering (min_gap_us == 0: periodic only)
+  uint32_t min_gap_us;
+  bool trigger_pending;
+  uint64_t last_start_us;
+
+  // Statistics
+  uint32_t runs;
+  uint32_t triggered_runs;
+  uint32_t deadline_misses;
+  uint32_t last_jitter_us;
+  uint32_t max_jitter_us;
+  uint64_t jitter_sum_us;
+  uint32_t last_exec_us;
+  uint32_t max_exec_us;
+} sched_group_t;
+
+typedef struct {
+  sched_group_t groups[SCHED_MAX_GROUPS];
+  uint8_t count;
+  sched_clock_t clock_us;
+} sched_core_t;
+
+/**
+ * @brief Initialize scheduler core
+ * @param core Core instance
+ * @param clock_us Monotonic microsecond clock used to time group bodies
+ */
+void sched_core_init(sched_core_t *core, sched_clock_t clock_us);
+
+/**
+ * @brief Add a rate group
+ *
+ * Groups run in the order they are added when released together, so add
+ * the fastest group first (rate-monotonic priority).
+ *
+ * @param core Core instance
+ * @param name Group name (for stats)
+ * @param period_us Release period in microseconds
+ * @param fn Group body
+ * @return Group index, or -1 if the table is full
+ */
+int sched_core_add_group(sched_core_t *core, const char *name,
+                         uint32_t period_us, sched_fn_t fn);
+
+/**
+ * @brief Set the first release of every group to a common epoch
+ * @param core Core instance
+ * @param now_us Epoch in microseconds
+ */
+void sched_core_start(sched_core_t *core, uint64_t now_us);
+
+/**
+ * @brief Allow a group to be run out of schedule by sched_core_trigger()
+ * @param core Core instance
+ * @param idx Group index
+ * @param min_gap_us Minimum time between two starts of the group
+ */
+void sched_core_set_trigger(sched_core_t *core, int idx, uint32_t min_gap_us);
+
+/**
+ * @brief Request an out-of-schedule run of a group
+ *
+ * The run happens in the next sched_core_run_due() call, as soon as the
+ * group's minimum gap since its last start has elapsed. Periodic releases
+ * continue unchanged and act as a fallback.
+ *
+ * @param core Core instance
+ * @param idx Group index
+ */
+void sched_core_trigger(sched_core_t *core, int idx);
+
+/**
+ * @brief Earliest time a deferred trigger may run
+ * @param core Core instance
+ * @return Time in microseconds, or UINT64_MAX if no trigger is pending
+ */
+uint64_t sched_core_next_trigger(const sched_core_t *core);
+
+/**
+ * @brief Run every group whose release time has passed
+ * @param core Core instance
+ * @param now_us Current time in microseconds
+ * @return Earliest pending release (or deferred trigger) time in microseconds
+ */
+uint64_t sched_core_run_due(sched_core_t *core, uint64_t now_us);
+
+/**
+ * @brief Greatest common divisor of all group periods
+ * @param core Core instance
+ * @return Base tick period in microseconds (0 if no groups)
+ */
+uint32_t sched_core_base_period(const sched_core_t *core);
+
+/**
+ * @brief Copy statistics of one group
+ * @param core Core instance
+ * @param idx Group index
+ * @param out Destination
+ * @return false if idx is out of range
+ */
+bool sched_core_get_stats(const sched_core_t *core, int idx,
+                          sched_stats_t *out);
+
+/**
+ * @brief Clear statistics of all groups
+ * @param core Core instance
+ */
+void sched_core_reset_stats(sched_core_t *core);
+
+#endif // SCHED_CORE_H
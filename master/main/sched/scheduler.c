@@ -0,0 +1,135 @@
+/**
+ * @file scheduler.c
+ * @brief Timer-driven rate-group executive (FreeRTOS + esp_timer)
+ */
+
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <stdatomic.h>
+
+#include "config.h"
+#include "scheduler.h"
+
+static const char *TAG = "SCHED";
+
+static sched_core_t s_core;
+static esp_timer_handle_t s_base_timer = NULL;
+static TaskHandle_t s_exec_task_handle = NULL;
+
+// Notification bits of the executive task
+#define NOTIFY_TICK (1u << 0)
+#define NOTIFY_TRIGGER (1u << 1)
+
+// Groups triggered from other tasks, consumed by the executive
+static atomic_uint s_trigger_mask;
+
+// ============================================================
+// CLOCK
+// ============================================================
+static uint64_t clock_us(void) { return (uint64_t)esp_timer_get_time(); }
+
+// ============================================================
+// BASE TIMER CALLBACK
+// ============================================================
+static void base_timer_cb(void *arg) {
+  if (s_exec_task_handle) {
+    xTaskNotify(s_exec_task_handle, NOTIFY_TICK, eSetBits);
+  }
+}
+
+// ============================================================
+// EXECUTIVE TASK
+// ============================================================
+static void executive_task(void *arg) {
+  ESP_LOGI(TAG, "Executive started, base period %lu us",
+           (unsigned long)sched_core_base_period(&s_core));
+
+  while (1) {
+    uint32_t mask = atomic_exchange(&s_trigger_mask, 0);
+    for (int i = 0; mask; i++, mask >>= 1) {
+      if (mask & 1) {
+        sched_core_trigger(&s_core, i);
+      }
+    }
+
+    sched_core_run_due(&s_core, clock_us());
+
+    // The base timer covers periodic releases; a timeout is only needed
+    // for a trigger deferred by its minimum gap.
+    TickType_t wait = portMAX_DELAY;
+    uint64_t deferred = sched_core_next_trigger(&s_core);
+    if (deferred != UINT64_MAX) {
+      uint64_t now = clock_us();
+      uint64_t us = (deferred > now) ? deferred - now : 0;
+      wait = pdMS_TO_TICKS((uint32_t)((us + 999) / 1000)) + 1;
+    }
+
+    uint32_t bits;
+    xTaskNotifyWait(0, UINT32_MAX, &bits, wait);
+  }
+}
+
+// ============================================================
+// PUBLIC API
+// ============================================================
+void scheduler_init(void) { sched_core_init(&s_core, clock_us); }
+
+int scheduler_add_group(const char *name, uint32_t period_us, sched_fn_t fn) {
+  int idx = sched_core_add_group(&s_core, name, period_us, fn);
+  if (idx < 0) {
+    ESP_LOGE(TAG, "Cannot add group %s", name);
+  }
+  return idx;
+}
+
+void scheduler_enable_trigger(int idx, uint32_t min_gap_us) {
+  sched_core_set_trigger(&s_core, idx, min_gap_us);
+}
+
+void scheduler_trigger(int idx) {
+  if (idx < 0 || idx >= SCHED_MAX_GROUPS || !s_exec_task_handle) {
+    return;
+  }
+  atomic_fetch_or(&s_trigger_mask, 1u << idx);
+  xTaskNotify(s_exec_task_handle, NOTIFY_TRIGGER, eSetBits);
+}
+
+void scheduler_start(void) {
+  uint32_t base_us = sched_core_base_period(&s_core);
+  if (base_us == 0) {
+    ESP_LOGE(TAG, "No rate groups registered");
+    return;
+  }
+
+  const esp_timer_create_args_t timer_args = {
+      .callback = base_timer_cb,
+      .name = "sched_base",
+  };
+  ESP_ERROR_CHECK(esp_timer_create(&timer_args, &s_base_timer));
+
+  // Epoch first, timer second: every tick then lands at or after a release
+  sched_core_start(&s_core, clock_us());
+  xTaskCreate(executive_task, "executive", SCHED_TASK_STACK, NULL,
+              SCHED_TASK_PRIO, &s_exec_task_handle);
+  ESP_ERROR_CHECK(esp_timer_start_periodic(s_base_timer, base_us));
+}
+
+bool scheduler_get_stats(int idx, sched_stats_t *out) {
+  return sched_core_get_stats(&s_core, idx, out);
+}
+
+void scheduler_log_stats(void) {
+  sched_stats_t st;
+  for (int i = 0; sched_core_get_stats(&s_core, i, &st); i++) {
+    ESP_LOGI(TAG,
+             "%-8s %5lu us: runs=%lu trig=%lu miss=%lu jit(avg/max)=%lu/%lu us "
+             "exec(max)=%lu us",
+             st.name, (unsigned long)st.period_us, (unsigned long)st.runs,
+             (unsigned long)st.triggered_runs,
+             (unsigned long)st.deadline_misses,
+             (unsigned long)st.mean_jitter_us, (unsigned long)st.max_jitter_us,
+             (unsigned long)st.max_exec_us);
+  }
+}
@@ -0,0 +1,68 @@
+/**
+ * @file scheduler.h
+ * @brief Timer-driven rate-group executive
+ *
+ * One FreeRTOS task runs every periodic job of the firmware. An esp_timer
+ * fires at the greatest common divisor of the group periods and wakes the
+ * executive, which runs whichever groups are due. Releases are anchored to
+ * a fixed schedule, so group periods do not drift with execution time.
+ */
+
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "sched_core.h"
+
+/**
+ * @brief Initialize executive (before adding groups)
+ */
+void scheduler_init(void);
+
+/**
+ * @brief Register a rate group
+ *
+ * Group bodies run on the executive task and must not block. Add the
+ * fastest group first.
+ *
+ * @param name Group name
+ * @param period_us Release period in microseconds
+ * @param fn Group body
+ * @return Group index, or -1 on error
+ */
+int scheduler_add_group(const char *name, uint32_t period_us, sched_fn_t fn);
+
+/**
+ * @brief Let a group be run on demand, in addition to its period
+ * @param idx Group index
+ * @param min_gap_us Minimum time between two starts of the group
+ */
+void scheduler_enable_trigger(int idx, uint32_t min_gap_us);
+
+/**
+ * @brief Request an immediate run of a group (any task, never blocks)
+ * @param idx Group index (must have triggering enabled)
+ */
+void scheduler_trigger(int idx);
+
+/**
+ * @brief Start the base timer and the executive task
+ */
+void scheduler_start(void);
+
+/**
+ * @brief Get timing statistics of one group
+ * @param idx Group index
+ * @param out Destination
+ * @return false if idx is out of range
+ */
+bool scheduler_get_stats(int idx, sched_stats_t *out);
+
+/**
+ * @brief Log timing statistics of all groups
+ */
+void scheduler_log_stats(void);
+
+#endif // SCHEDULER_H
@@ -61,6 +61,19 @@ typedef enum {
   BTN_EVT_OK_LONG,
 } button_event_t;
 
+// ============================================================
+// JOYSTICK DATA (from slave)
+// ============================================================
+typedef struct {
+  int16_t throttle; // -255 to 255 (Y axis)
+  int16_t steering; // -255 to 255 (X axis)
+  int16_t aux_x;    // mecanum rotation (omega)
+  int16_t aux_y;    // unused
+  bool btn1;        // emergency stop
+  bool btn2;        // unused
+  uint8_t mode;     // unused
+} joystick_data_t;
+
 // ============================================================
 // SYSTEM EVENTS (for FreeRTOS queue)
 // ============================================================
@@ -75,26 +88,18 @@ typedef enum {
 
 typedef struct {
   event_type_t type;
+  int64_t stamp_us; // When the event was raised
   union {
     button_event_t button;
-    uint8_t voice_cmd;
+    joystick_data_t joystick; // Whole frame, so traces replay exactly
+    struct {
+      uint8_t cmd;
+      uint8_t speed;
+    } voice;
     system_state_t new_state;
   } data;
 } system_event_t;
 
-// ============================================================
-// JOYSTICK DATA (from slave)
-// ============================================================
-typedef struct {
-  int16_t throttle; // -255 to 255 (Y axis)
-  int16_t steering; // -255 to 255 (X axis)
-  int16_t aux_x;    // unused
-  int16_t aux_y;    // unused
-  bool btn1;        // emergency stop
-  bool btn2;        // unused
-  uint8_t mode;     // unused
-} joystick_data_t;
-
 // ============================================================
 // MOTOR SPEEDS
 // ============================================================
@@ -115,6 +120,9 @@ typedef struct {
   uint8_t motor_cal_fr;
   uint8_t motor_cal_bl;
   uint8_t motor_cal_br;
+  uint16_t ramp_accel[4]; // Wheel ramps FL, FR, BL, BR (duty/s, 0 = off)
+  uint16_t ramp_decel[4];
+  uint16_t ramp_jerk; // duty/s^2, 0 = off
 } settings_data_t;
 
 // ============================================================
@@ -132,6 +140,8 @@ typedef struct {
   bool voice_connected;
   uint32_t last_joystick_time;
   uint32_t last_voice_time;
+  uint32_t joystick_frames;  // Frames received so far
+  int64_t joystick_rx_us;    // Arrival time of g_ctx.joystick
 
   // Joystick data
   joystick_data_t joystick;
@@ -143,6 +153,8 @@ typedef struct {
   // Movement
   movement_type_t movement;
   motor_speeds_t motor_speeds;
+  uint32_t control_loop_us; // Duration of the latest control cycle
+  bool estop_latched;       // Emergency stop not yet cleared (fsm.h)
 
   // Settings
   settings_data_t settings;
@@ -0,0 +1,40 @@
+/**
+ * @file font.h
+ * @brief Packed bitmap fonts
+ *
+ * Atlases are generated by master/tools/gen_fonts.py into font_data.c and
+ * live in flash (rodata). Glyphs are page-organised bands of column bytes,
+ * ready for display_blit().
+ */
+
+#ifndef FONT_H
+#define FONT_H
+
+#include <stdint.h>
+
+#define FONT_NO_GLYPH 0xFFFF
+
+typedef struct {
+  uint8_t first;          // Code of the first character
+  uint8_t count;          // Characters covered, first .. first + count - 1
+  uint8_t height;         // Glyph height in pixels
+  uint8_t spacing;        // Columns between glyphs
+  const uint16_t *offset; // Bitmap offset by char - first (FONT_NO_GLYPH)
+  const uint8_t *width;   // Glyph widths by char - first
+  const uint8_t *bitmap;  // ceil(height / 8) bands of width bytes per glyph
+} font_t;
+
+extern const font_t font_5x7;         // Printable ASCII, monospaced
+extern const font_t font_digits_8x16; // " -.0-9:"
+
+/**
+ * @brief Index of a character in a font, -1 if it has no glyph
+ */
+static inline int font_index(const font_t *font, char c) {
+  int i = (uint8_t)c - font->first;
+  if (i < 0 || i >= font->count || font->offset[i] == FONT_NO_GLYPH)
+    return -1;
+  return i;
+}
+
+#endif // FONT_H
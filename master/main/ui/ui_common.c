@@ -5,6 +5,8 @@
 
 #include "ui_common.h"
 #include "config.h"
+#include "espnow_handler.h"
+#include "link_stats.h"
 #include "types.h"
 #include <stdio.h>
 
@@ -13,31 +15,11 @@
 // DRAW HEADER
 // ============================================================
 void ui_draw_header(const char *title) {
-  // Draw header line
+  // Filled bar with the title inverted into it
   display_fill_rect(0, 0, OLED_WIDTH, 10, true);
 
-  // Draw title (inverted)
-  int x = (OLED_WIDTH - strlen(title) * 6) / 2;
-  for (int i = 0; title[i]; i++) {
-    // Draw inverted character
-    for (int col = 0; col < 5; col++) {
-      for (int row = 0; row < 7; row++) {
-        display_set_pixel(x + col, 1 + row, false);
-      }
-    }
-    display_draw_char(x, 1, title[i]);
-    // Invert the character
-    for (int col = 0; col < 6; col++) {
-      for (int row = 0; row < 8; row++) {
-        int px_x = x + col;
-        int px_y = 1 + row;
-        if (px_x < OLED_WIDTH && px_y < 10) {
-          // Toggle pixel for inversion effect
-        }
-      }
-    }
-    x += 6;
-  }
+  int x = (OLED_WIDTH - display_text_width(title, &font_5x7)) / 2;
+  display_draw_string_mode(x, 1, title, DRAW_XOR);
 }
 
 // ============================================================
@@ -46,18 +28,7 @@ void ui_draw_header(const char *title) {
 void ui_draw_menu_item(int y, const char *text, bool selected) {
   if (selected) {
     display_fill_rect(0, y, OLED_WIDTH, 10, true);
-    // Draw inverted text
-    int x = 4;
-    for (int i = 0; text[i] && x < OLED_WIDTH - 6; i++) {
-      // We need to invert - draw white background already done
-      // Just draw the char normally then invert
-      display_draw_char(x, y + 1, text[i]);
-      x += 6;
-    }
-    // Invert: clear the character pixels (since bg is white)
-    // For simplicity, just draw "> " indicator
-    display_draw_string(0, y + 1, ">");
-    display_draw_string(8, y + 1, text);
+    display_draw_string_mode(8, y + 1, text, DRAW_XOR);
   } else {
     display_draw_string(8, y + 1, text);
   }
@@ -66,17 +37,21 @@ void ui_draw_menu_item(int y, const char *text, bool selected) {
 // ============================================================
 // DRAW STATUS BAR
 // ============================================================
+bool ui_joystick_link_weak(void) {
+  // The controller's link, not whichever peer spoke last (voice slave)
+  uint8_t mac[6];
+  return espnow_handler_get_controller(mac) && link_stats_weak(mac);
+}
+
 void ui_draw_status_bar(void) {
   int y = OLED_HEIGHT - 9;
 
   // Draw separator line
-  for (int x = 0; x < OLED_WIDTH; x++) {
-    display_set_pixel(x, y, true);
-  }
+  display_draw_hline(0, y, OLED_WIDTH, true);
 
-  // Joystick status
+  // Joystick status (LO: averaged RSSI close to dropping out)
   if (g_ctx.joystick_connected) {
-    display_draw_string(2, y + 2, "JOY:OK");
+    display_draw_string(2, y + 2, ui_joystick_link_weak() ? "JOY:LO" : "JOY:OK");
   } else {
     display_draw_string(2, y + 2, "JOY:--");
   }
@@ -103,6 +78,29 @@ void ui_draw_progress_bar(int x, int y, int w, int h, uint8_t value) {
   display_fill_rect(x + 2, y + 2, fill_w, h - 4, true);
 }
 
+// ============================================================
+// DRAW SIGNED BAR
+// ============================================================
+void ui_draw_signed_bar(int x, int y, int w, int h, int value) {
+  display_draw_rect(x, y, w, h);
+
+  // Fill grows from the centre towards the side of the sign
+  int half = (w - 4) / 2;
+  int mid = x + 2 + half;
+  int mag = value < 0 ? -value : value;
+  if (mag > 255) {
+    mag = 255;
+  }
+  int fill_w = (half * mag) / 255;
+
+  display_draw_vline(mid, y + 1, h - 2, true);
+  if (value > 0) {
+    display_fill_rect(mid, y + 2, fill_w, h - 4, true);
+  } else if (value < 0) {
+    display_fill_rect(mid - fill_w, y + 2, fill_w, h - 4, true);
+  }
+}
+
 // ============================================================
 // DRAW MOVEMENT INDICATOR
 // ============================================================
@@ -143,6 +141,6 @@ void ui_draw_movement(int movement) {
   }
 
   // Center the text
-  int x = (OLED_WIDTH - strlen(str) * 6) / 2;
+  int x = (OLED_WIDTH - display_text_width(str, &font_5x7)) / 2;
   display_draw_string(x, 30, str);
 }
@@ -7,13 +7,38 @@
 #define UI_COMMON_H
 
 #include <stdbool.h>
+#include <stdint.h>
+
+#include "font.h"
+
+// How set bits of a glyph or column bitmap combine with the framebuffer
+typedef enum {
+  DRAW_SET,   // Turn pixels on
+  DRAW_CLEAR, // Turn pixels off
+  DRAW_XOR,   // Invert pixels (text on filled bars)
+} draw_mode_t;
 
 // Display drawing primitives (implemented in display.c)
 extern void display_set_pixel(int x, int y, bool on);
+extern void display_blit_columns(int x, int y, const uint8_t *cols, int w,
+                                 int h, draw_mode_t mode);
 extern void display_draw_char(int x, int y, char c);
+extern void display_draw_char_mode(int x, int y, char c, draw_mode_t mode);
 extern void display_draw_string(int x, int y, const char *str);
+extern void display_draw_string_mode(int x, int y, const char *str,
+                                     draw_mode_t mode);
+extern int display_draw_text(int x, int y, const char *str,
+                             const font_t *font, draw_mode_t mode);
+extern int display_text_width(const char *str, const font_t *font);
+extern void display_blit(int x, int y, const uint8_t *bitmap, int w, int h,
+                         draw_mode_t mode);
 extern void display_fill_rect(int x, int y, int w, int h, bool on);
+extern void display_fill_rect_mode(int x, int y, int w, int h,
+                                   draw_mode_t mode);
+extern void display_draw_hline(int x, int y, int w, bool on);
+extern void display_draw_vline(int x, int y, int h, bool on);
 extern void display_draw_rect(int x, int y, int w, int h);
+extern void display_draw_line(int x0, int y0, int x1, int y1, bool on);
 
 /**
  * @brief Draw menu header
@@ -29,6 +54,11 @@ void ui_draw_header(const char *title);
  */
 void ui_draw_menu_item(int y, const char *text, bool selected);
 
+/**
+ * @brief True when the joystick controller's averaged RSSI is weak
+ */
+bool ui_joystick_link_weak(void);
+
 /**
  * @brief Draw connection status bar
  */
@@ -41,6 +71,13 @@ void ui_draw_status_bar(void);
  */
 void ui_draw_progress_bar(int x, int y, int w, int h, uint8_t value);
 
+/**
+ * @brief Draw centre-zero bar
+ * @param x, y, w, h Position and size
+ * @param value Signed value (-255 to 255), filled from the centre
+ */
+void ui_draw_signed_bar(int x, int y, int w, int h, int value);
+
 /**
  * @brief Draw movement indicator
  * @param movement Movement type
@@ -0,0 +1,134 @@
+/**
+ * @file ui_telemetry.c
+ * @brief Live telemetry page implementation
+ *
+ *   rows 12-47  wheel name, centre-zero duty bar, duty
+ *   rows 48-63  packet rate and RSSI in font_digits_8x16; loss and
+ *               control-loop time in 5x7 beside them
+ */
+
+#include "config.h"
+#include "display.h"
+#include "espnow_handler.h"
+#include "hal_clock.h"
+#include "link_stats.h"
+#include "types.h"
+#include "ui_common.h"
+#include "ui_telemetry.h"
+#include "ui_widgets.h"
+
+#define ROW_Y(i) (12 + (i) * 9)
+
+static const char *const s_wheel_names[4] = {"FL", "FR", "BL", "BR"};
+
+static ui_widget_t s_bars[4], s_duty[4];
+static ui_widget_t s_rate, s_loss, s_rssi, s_loop;
+static ui_widget_t *const s_widgets[] = {
+    &s_bars[0], &s_bars[1], &s_bars[2], &s_bars[3], &s_duty[0],
+    &s_duty[1], &s_duty[2], &s_duty[3], &s_rate,    &s_loss,
+    &s_rssi,    &s_loop,
+};
+#define WIDGET_COUNT (int)(sizeof(s_widgets) / sizeof(s_widgets[0]))
+
+// Rate cap
+static int64_t s_last_draw_us = 0;
+
+// Packet rate / loss averaging window
+static int64_t s_window_us = 0;
+static uint32_t s_window_packets = 0;
+static uint32_t s_window_lost = 0;
+static int32_t s_rate_hz = 0;
+static int32_t s_loss_pct = 0;
+
+// ============================================================
+// VALUES
+// ============================================================
+static void update_window(int64_t now, const link_peer_stats_t *ls) {
+  int64_t span = now - s_window_us;
+
+  if (s_window_us && span < TELEMETRY_WINDOW_MS * 1000) {
+    return;
+  }
+  if (s_window_us) {
+    uint32_t packets = ls->packets - s_window_packets;
+    uint32_t lost = ls->lost - s_window_lost;
+    s_rate_hz = (int32_t)((packets * 1000000LL + span / 2) / span);
+    s_loss_pct =
+        (packets + lost) ? (int32_t)((lost * 100) / (packets + lost)) : 0;
+  }
+  s_window_us = now;
+  s_window_packets = ls->packets;
+  s_window_lost = ls->lost;
+}
+
+static int update_widgets(int64_t now) {
+  const int16_t duty[4] = {g_ctx.motor_speeds.fl, g_ctx.motor_speeds.fr,
+                           g_ctx.motor_speeds.bl, g_ctx.motor_speeds.br};
+  link_peer_stats_t ls = {0};
+  uint8_t mac[6];
+
+  // The joystick's link, not whichever peer spoke last (voice slave)
+  if (espnow_handler_get_controller(mac)) {
+    link_stats_find(mac, &ls);
+  }
+  update_window(now, &ls);
+
+  for (int i = 0; i < 4; i++) {
+    ui_widget_set(&s_bars[i], duty[i]);
+    ui_widget_set(&s_duty[i], duty[i]);
+  }
+  // Fixed-width cells: clamp instead of overflowing the box
+  int32_t rssi = ls.rssi_avg_q4 / 16;
+  uint32_t loop_us = g_ctx.control_loop_us;
+  ui_widget_set(&s_rate, s_rate_hz > 999 ? 999 : s_rate_hz);
+  ui_widget_set(&s_loss, s_loss_pct);
+  ui_widget_set(&s_rssi, rssi < -99 ? -99 : rssi);
+  ui_widget_set(&s_loop, loop_us > 9999 ? 9999 : (int32_t)loop_us);
+
+  s_last_draw_us = now;
+  return ui_widgets_render(s_widgets, WIDGET_COUNT);
+}
+
+// Time the last flush kept the bus busy, scaled up to the allowed share
+static int64_t min_gap_us(void) {
+  display_flush_stats_t st;
+  display_get_flush_stats(&st);
+
+  int64_t gap = (int64_t)st.last_us * 100 / TELEMETRY_BUS_SHARE_PCT;
+  if (gap < TELEMETRY_MIN_PERIOD_MS * 1000) {
+    gap = TELEMETRY_MIN_PERIOD_MS * 1000;
+  }
+  return gap;
+}
+
+// ============================================================
+// PUBLIC API
+// ============================================================
+void ui_telemetry_draw(void) {
+  ui_draw_header("TELEMETRY");
+
+  for (int i = 0; i < 4; i++) {
+    display_draw_string(0, ROW_Y(i), s_wheel_names[i]);
+    ui_widget_init_signed_bar(&s_bars[i], 14, ROW_Y(i), 72, 7);
+    ui_widget_init_value(&s_duty[i], 92, ROW_Y(i), "%4d", 4);
+  }
+
+  // Bottom band: packet rate and RSSI in large digits, units beside them
+  ui_widget_init_big(&s_rate, 0, ROW_Y(4), "%d", 3, &font_digits_8x16);
+  display_draw_string(30, ROW_Y(4), "Hz");
+  ui_widget_init_value(&s_loss, 30, ROW_Y(4) + 8, "%3d%%", 4);
+  ui_widget_init_big(&s_rssi, 58, ROW_Y(4), "%d", 3, &font_digits_8x16);
+  display_draw_string(88, ROW_Y(4), "dBm");
+  ui_widget_init_value(&s_loop, 88, ROW_Y(4) + 8, "%4dus", 6);
+
+  update_widgets(hal_time_us());
+}
+
+bool ui_telemetry_refresh(void) {
+  int64_t now = hal_time_us();
+
+  if (now - s_last_draw_us < min_gap_us()) {
+    return false;
+  }
+  return update_widgets(now) > 0;
+}
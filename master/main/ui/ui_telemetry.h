@@ -0,0 +1,26 @@
+/**
+ * @file ui_telemetry.h
+ * @brief Live telemetry page shared by the driving modes
+ *
+ * Wheel duty bars, packet rate and loss, RSSI and control-loop time.
+ * Refreshes are capped at TELEMETRY_MIN_PERIOD_MS and spaced so the page
+ * keeps the OLED bus busy at most TELEMETRY_BUS_SHARE_PCT of the time.
+ */
+
+#ifndef UI_TELEMETRY_H
+#define UI_TELEMETRY_H
+
+#include <stdbool.h>
+
+/**
+ * @brief Draw the whole page
+ */
+void ui_telemetry_draw(void);
+
+/**
+ * @brief Redraw changed values if the rate cap allows
+ * @return true if anything was drawn
+ */
+bool ui_telemetry_refresh(void);
+
+#endif // UI_TELEMETRY_H
@@ -0,0 +1,141 @@
+/**
+ * @file ui_widgets.c
+ * @brief Retained widgets implementation
+ */
+
+#include <stdio.h>
+
+#include "config.h"
+#include "types.h"
+#include "ui_common.h"
+#include "ui_widgets.h"
+
+#define STATUS_JOY 0x01
+#define STATUS_VOICE 0x02
+#define STATUS_WEAK 0x04
+
+// ============================================================
+// CONSTRUCTORS
+// ============================================================
+static void init_box(ui_widget_t *w, ui_widget_kind_t kind, int x, int y,
+                     int width, int height, const char *text) {
+  w->kind = kind;
+  w->x = x;
+  w->y = y;
+  w->w = width;
+  w->h = height;
+  w->text = text;
+  w->font = NULL;
+  w->value = 0;
+  w->drawn = 0;
+  w->valid = false;
+}
+
+void ui_widget_init_label(ui_widget_t *w, int x, int y, const char *text) {
+  init_box(w, UI_WIDGET_LABEL, x, y, display_text_width(text, &font_5x7), 8,
+           text);
+}
+
+void ui_widget_init_value(ui_widget_t *w, int x, int y, const char *fmt,
+                          int chars) {
+  // font_5x7 is monospaced: every cell is glyph + spacing wide
+  int cell = font_5x7.width[0] + font_5x7.spacing;
+  init_box(w, UI_WIDGET_VALUE, x, y, chars * cell, 8, fmt);
+}
+
+void ui_widget_init_big(ui_widget_t *w, int x, int y, const char *fmt,
+                        int chars, const font_t *font) {
+  // Digits are tabular; '-' is as wide as a digit
+  int cell = font->width[font_index(font, '0')] + font->spacing;
+  init_box(w, UI_WIDGET_BIG, x, y, chars * cell - font->spacing, font->height,
+           fmt);
+  w->font = font;
+}
+
+void ui_widget_init_bar(ui_widget_t *w, int x, int y, int width, int height) {
+  init_box(w, UI_WIDGET_BAR, x, y, width, height, NULL);
+}
+
+void ui_widget_init_signed_bar(ui_widget_t *w, int x, int y, int width,
+                               int height) {
+  init_box(w, UI_WIDGET_SIGNED, x, y, width, height, NULL);
+}
+
+void ui_widget_init_status(ui_widget_t *w) {
+  init_box(w, UI_WIDGET_STATUS, 0, OLED_HEIGHT - 9, OLED_WIDTH, 9, NULL);
+}
+
+void ui_widget_init_movement(ui_widget_t *w) {
+  init_box(w, UI_WIDGET_MOVEMENT, 0, 30, OLED_WIDTH, 8, NULL);
+}
+
+// ============================================================
+// STATE
+// ============================================================
+void ui_widget_set(ui_widget_t *w, int32_t value) {
+  w->value = value;
+  if (value != w->drawn) {
+    w->valid = false;
+  }
+}
+
+void ui_widget_invalidate(ui_widget_t *w) { w->valid = false; }
+
+int32_t ui_status_bits(void) {
+  int32_t bits = (g_ctx.joystick_connected ? STATUS_JOY : 0) |
+                 (g_ctx.voice_connected ? STATUS_VOICE : 0);
+  if ((bits & STATUS_JOY) && ui_joystick_link_weak())
+    bits |= STATUS_WEAK;
+  return bits;
+}
+
+// ============================================================
+// RENDERING
+// ============================================================
+static void draw(const ui_widget_t *w) {
+  char buf[24];
+
+  switch (w->kind) {
+  case UI_WIDGET_LABEL:
+    display_draw_string(w->x, w->y, w->text);
+    break;
+  case UI_WIDGET_VALUE:
+    snprintf(buf, sizeof(buf), w->text, (int)w->value);
+    display_draw_string(w->x, w->y, buf);
+    break;
+  case UI_WIDGET_BIG:
+    snprintf(buf, sizeof(buf), w->text, (int)w->value);
+    display_draw_text(w->x + w->w - display_text_width(buf, w->font), w->y,
+                      buf, w->font, DRAW_SET);
+    break;
+  case UI_WIDGET_BAR:
+    ui_draw_progress_bar(w->x, w->y, w->w, w->h, (uint8_t)w->value);
+    break;
+  case UI_WIDGET_SIGNED:
+    ui_draw_signed_bar(w->x, w->y, w->w, w->h, (int)w->value);
+    break;
+  case UI_WIDGET_STATUS:
+    ui_draw_status_bar();
+    break;
+  case UI_WIDGET_MOVEMENT:
+    ui_draw_movement(w->value);
+    break;
+  }
+}
+
+int ui_widgets_render(ui_widget_t *const widgets[], int n) {
+  int drawn = 0;
+
+  for (int i = 0; i < n; i++) {
+    ui_widget_t *w = widgets[i];
+    if (w->valid) {
+      continue;
+    }
+    display_fill_rect(w->x, w->y, w->w, w->h, false);
+    draw(w);
+    w->drawn = w->value;
+    w->valid = true;
+    drawn++;
+  }
+  return drawn;
+}
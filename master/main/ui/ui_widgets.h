@@ -0,0 +1,105 @@
+/**
+ * @file ui_widgets.h
+ * @brief Retained widgets with per-widget invalidation
+ *
+ * A widget remembers the value it last rendered and its bounding box.
+ * Setting a new value only marks it invalid; rendering redraws invalid
+ * widgets inside their own box and leaves the rest of the frame alone,
+ * so the flush sends just the changed bytes.
+ */
+
+#ifndef UI_WIDGETS_H
+#define UI_WIDGETS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "font.h"
+
+typedef enum {
+  UI_WIDGET_LABEL,    // Fixed text
+  UI_WIDGET_VALUE,    // printf-formatted integer
+  UI_WIDGET_BIG,      // Integer in a digit font, right-aligned
+  UI_WIDGET_BAR,      // Progress bar, value 0-255
+  UI_WIDGET_SIGNED,   // Centre-zero bar, value -255 to 255
+  UI_WIDGET_STATUS,   // Connection status bar, value from ui_status_bits()
+  UI_WIDGET_MOVEMENT, // Centred movement label, value movement_type_t
+} ui_widget_kind_t;
+
+typedef struct {
+  ui_widget_kind_t kind;
+  int16_t x, y, w, h; // Bounding box
+  const char *text;   // Label text or value format
+  const font_t *font; // Digit font (UI_WIDGET_BIG)
+  int32_t value;      // Requested value
+  int32_t drawn;      // Value currently on screen
+  bool valid;         // drawn matches value
+} ui_widget_t;
+
+/**
+ * @brief Fixed text label
+ */
+void ui_widget_init_label(ui_widget_t *w, int x, int y, const char *text);
+
+/**
+ * @brief Formatted value
+ * @param fmt printf format with one int conversion
+ * @param chars Widest rendered text in characters (sets the box)
+ */
+void ui_widget_init_value(ui_widget_t *w, int x, int y, const char *fmt,
+                          int chars);
+
+/**
+ * @brief Large number
+ * @param fmt printf format with one int conversion
+ * @param chars Most digits (or '-') rendered (sets the box)
+ * @param font Digit font, e.g. font_digits_8x16
+ */
+void ui_widget_init_big(ui_widget_t *w, int x, int y, const char *fmt,
+                        int chars, const font_t *font);
+
+/**
+ * @brief Progress bar
+ */
+void ui_widget_init_bar(ui_widget_t *w, int x, int y, int width, int height);
+
+/**
+ * @brief Centre-zero bar for signed values
+ */
+void ui_widget_init_signed_bar(ui_widget_t *w, int x, int y, int width,
+                               int height);
+
+/**
+ * @brief Connection status bar at the bottom of the screen
+ */
+void ui_widget_init_status(ui_widget_t *w);
+
+/**
+ * @brief Movement indicator in the middle of the screen
+ */
+void ui_widget_init_movement(ui_widget_t *w);
+
+/**
+ * @brief Update a widget's value (invalidates it if the value changed)
+ */
+void ui_widget_set(ui_widget_t *w, int32_t value);
+
+/**
+ * @brief Force a widget to be redrawn
+ */
+void ui_widget_invalidate(ui_widget_t *w);
+
+/**
+ * @brief Redraw every invalid widget in its box
+ * @param widgets Widget list
+ * @param n Number of widgets
+ * @return Number of widgets redrawn
+ */
+int ui_widgets_render(ui_widget_t *const widgets[], int n);
+
+/**
+ * @brief Current connection flags for a status widget
+ */
+int32_t ui_status_bits(void);
+
+#endif // UI_WIDGETS_H
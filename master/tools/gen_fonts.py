@@ -0,0 +1,288 @@
+#!/usr/bin/env python3
+"""Generate the packed font atlases in master/main/ui/font_data.c.
+
+    python3 master/tools/gen_fonts.py
+
+Glyphs are stored the way the OLED framebuffer is organised: ceil(h / 8)
+bands of column bytes (LSB = top row), band after band, so a glyph is
+drawn with one display_blit(). Each atlas has a direct-index offset table
+(char - first -> byte offset, or FONT_NO_GLYPH) and a width table used
+for advance and kerning.
+
+Sources:
+  * 5x7: the original column font (printable ASCII), monospaced.
+  * 8x16 digits: seven-segment shapes rasterised here, with tabular
+    digits and narrow punctuation.
+"""
+
+import os
+
+OUT = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "main",
+                   "ui", "font_data.c")
+
+NO_GLYPH = 0xFFFF
+
+# ============================================================
+# 5x7 SOURCE (column bytes, LSB = top row), ' ' .. '~'
+# ============================================================
+FONT_5X7 = [
+    [0x00, 0x00, 0x00, 0x00, 0x00],  # Space
+    [0x00, 0x00, 0x5F, 0x00, 0x00],  # !
+    [0x00, 0x07, 0x00, 0x07, 0x00],  # "
+    [0x14, 0x7F, 0x14, 0x7F, 0x14],  # #
+    [0x24, 0x2A, 0x7F, 0x2A, 0x12],  # $
+    [0x23, 0x13, 0x08, 0x64, 0x62],  # %
+    [0x36, 0x49, 0x55, 0x22, 0x50],  # &
+    [0x00, 0x05, 0x03, 0x00, 0x00],  # '
+    [0x00, 0x1C, 0x22, 0x41, 0x00],  # (
+    [0x00, 0x41, 0x22, 0x1C, 0x00],  # )
+    [0x08, 0x2A, 0x1C, 0x2A, 0x08],  # *
+    [0x08, 0x08, 0x3E, 0x08, 0x08],  # +
+    [0x00, 0x50, 0x30, 0x00, 0x00],  # ,
+    [0x08, 0x08, 0x08, 0x08, 0x08],  # -
+    [0x00, 0x60, 0x60, 0x00, 0x00],  # .
+    [0x20, 0x10, 0x08, 0x04, 0x02],  # /
+    [0x3E, 0x51, 0x49, 0x45, 0x3E],  # 0
+    [0x00, 0x42, 0x7F, 0x40, 0x00],  # 1
+    [0x42, 0x61, 0x51, 0x49, 0x46],  # 2
+    [0x21, 0x41, 0x45, 0x4B, 0x31],  # 3
+    [0x18, 0x14, 0x12, 0x7F, 0x10],  # 4
+    [0x27, 0x45, 0x45, 0x45, 0x39],  # 5
+    [0x3C, 0x4A, 0x49, 0x49, 0x30],  # 6
+    [0x01, 0x71, 0x09, 0x05, 0x03],  # 7
+    [0x36, 0x49, 0x49, 0x49, 0x36],  # 8
+    [0x06, 0x49, 0x49, 0x29, 0x1E],  # 9
+    [0x00, 0x36, 0x36, 0x00, 0x00],  # :
+    [0x00, 0x56, 0x36, 0x00, 0x00],  # ;
+    [0x00, 0x08, 0x14, 0x22, 0x41],  # <
+    [0x14, 0x14, 0x14, 0x14, 0x14],  # =
+    [0x41, 0x22, 0x14, 0x08, 0x00],  # >
+    [0x02, 0x01, 0x51, 0x09, 0x06],  # ?
+    [0x32, 0x49, 0x79, 0x41, 0x3E],  # @
+    [0x7E, 0x11, 0x11, 0x11, 0x7E],  # A
+    [0x7F, 0x49, 0x49, 0x49, 0x36],  # B
+    [0x3E, 0x41, 0x41, 0x41, 0x22],  # C
+    [0x7F, 0x41, 0x41, 0x22, 0x1C],  # D
+    [0x7F, 0x49, 0x49, 0x49, 0x41],  # E
+    [0x7F, 0x09, 0x09, 0x01, 0x01],  # F
+    [0x3E, 0x41, 0x41, 0x51, 0x32],  # G
+    [0x7F, 0x08, 0x08, 0x08, 0x7F],  # H
+    [0x00, 0x41, 0x7F, 0x41, 0x00],  # I
+    [0x20, 0x40, 0x41, 0x3F, 0x01],  # J
+    [0x7F, 0x08, 0x14, 0x22, 0x41],  # K
+    [0x7F, 0x40, 0x40, 0x40, 0x40],  # L
+    [0x7F, 0x02, 0x04, 0x02, 0x7F],  # M
+    [0x7F, 0x04, 0x08, 0x10, 0x7F],  # N
+    [0x3E, 0x41, 0x41, 0x41, 0x3E],  # O
+    [0x7F, 0x09, 0x09, 0x09, 0x06],  # P
+    [0x3E, 0x41, 0x51, 0x21, 0x5E],  # Q
+    [0x7F, 0x09, 0x19, 0x29, 0x46],  # R
+    [0x46, 0x49, 0x49, 0x49, 0x31],  # S
+    [0x01, 0x01, 0x7F, 0x01, 0x01],  # T
+    [0x3F, 0x40, 0x40, 0x40, 0x3F],  # U
+    [0x1F, 0x20, 0x40, 0x20, 0x1F],  # V
+    [0x7F, 0x20, 0x18, 0x20, 0x7F],  # W
+    [0x63, 0x14, 0x08, 0x14, 0x63],  # X
+    [0x03, 0x04, 0x78, 0x04, 0x03],  # Y
+    [0x61, 0x51, 0x49, 0x45, 0x43],  # Z
+    [0x00, 0x00, 0x7F, 0x41, 0x41],  # [
+    [0x02, 0x04, 0x08, 0x10, 0x20],  # backslash
+    [0x41, 0x41, 0x7F, 0x00, 0x00],  # ]
+    [0x04, 0x02, 0x01, 0x02, 0x04],  # ^
+    [0x40, 0x40, 0x40, 0x40, 0x40],  # _
+    [0x00, 0x01, 0x02, 0x04, 0x00],  # `
+    [0x20, 0x54, 0x54, 0x54, 0x78],  # a
+    [0x7F, 0x48, 0x44, 0x44, 0x38],  # b
+    [0x38, 0x44, 0x44, 0x44, 0x20],  # c
+    [0x38, 0x44, 0x44, 0x48, 0x7F],  # d
+    [0x38, 0x54, 0x54, 0x54, 0x18],  # e
+    [0x08, 0x7E, 0x09, 0x01, 0x02],  # f
+    [0x08, 0x14, 0x54, 0x54, 0x3C],  # g
+    [0x7F, 0x08, 0x04, 0x04, 0x78],  # h
+    [0x00, 0x44, 0x7D, 0x40, 0x00],  # i
+    [0x20, 0x40, 0x44, 0x3D, 0x00],  # j
+    [0x00, 0x7F, 0x10, 0x28, 0x44],  # k
+    [0x00, 0x41, 0x7F, 0x40, 0x00],  # l
+    [0x7C, 0x04, 0x18, 0x04, 0x78],  # m
+    [0x7C, 0x08, 0x04, 0x04, 0x78],  # n
+    [0x38, 0x44, 0x44, 0x44, 0x38],  # o
+    [0x7C, 0x14, 0x14, 0x14, 0x08],  # p
+    [0x08, 0x14, 0x14, 0x18, 0x7C],  # q
+    [0x7C, 0x08, 0x04, 0x04, 0x08],  # r
+    [0x48, 0x54, 0x54, 0x54, 0x20],  # s
+    [0x04, 0x3F, 0x44, 0x40, 0x20],  # t
+    [0x3C, 0x40, 0x40, 0x20, 0x7C],  # u
+    [0x1C, 0x20, 0x40, 0x20, 0x1C],  # v
+    [0x3C, 0x40, 0x30, 0x40, 0x3C],  # w
+    [0x44, 0x28, 0x10, 0x28, 0x44],  # x
+    [0x0C, 0x50, 0x50, 0x50, 0x3C],  # y
+    [0x44, 0x64, 0x54, 0x4C, 0x44],  # z
+    [0x00, 0x08, 0x36, 0x41, 0x00],  # {
+    [0x00, 0x00, 0x7F, 0x00, 0x00],  # |
+    [0x00, 0x41, 0x36, 0x08, 0x00],  # }
+    [0x08, 0x08, 0x2A, 0x1C, 0x08],  # ~
+]
+
+# ============================================================
+# SEVEN-SEGMENT DIGITS
+# ============================================================
+SEGMENTS = {
+    "0": "abcdef", "1": "bc", "2": "abdeg", "3": "abcdg", "4": "bcfg",
+    "5": "acdfg", "6": "acdefg", "7": "abc", "8": "abcdefg", "9": "abcdfg",
+    "-": "g",
+}
+
+
+def seg_rects(w, h, t):
+    """Segment rectangles (x0, y0, x1, y1), end exclusive."""
+    mid = h // 2
+    g0 = mid - t // 2
+    return {
+        "a": (0, 0, w, t),
+        "b": (w - t, 0, w, mid),
+        "c": (w - t, mid, w, h),
+        "d": (0, h - t, w, h),
+        "e": (0, mid, t, h),
+        "f": (0, 0, t, mid),
+        "g": (0, g0, w, g0 + t),
+    }
+
+
+def blank(w, h):
+    return [[0] * w for _ in range(h)]
+
+
+def fill(px, x0, y0, x1, y1):
+    for y in range(y0, y1):
+        for x in range(x0, x1):
+            px[y][x] = 1
+
+
+def segment_glyphs(w, h, t):
+    rects = seg_rects(w, h, t)
+    glyphs = {}
+    for ch, segs in SEGMENTS.items():
+        px = blank(w, h)
+        for s in segs:
+            fill(px, *rects[s])
+        glyphs[ch] = px
+    glyphs[" "] = blank(w // 2, h)
+    dot = blank(t, h)
+    fill(dot, 0, h - t, t, h)
+    glyphs["."] = dot
+    colon = blank(t, h)
+    fill(colon, 0, h // 3 - t // 2, t, h // 3 - t // 2 + t)
+    fill(colon, 0, 2 * h // 3 - t // 2, t, 2 * h // 3 - t // 2 + t)
+    glyphs[":"] = colon
+    return glyphs
+
+
+def columns_to_pixels(cols, h):
+    return [[(c >> y) & 1 for c in cols] for y in range(h)]
+
+
+# ============================================================
+# PACKING
+# ============================================================
+def pack(px, h):
+    """Pixel rows -> band-major page bytes."""
+    w = len(px[0]) if px else 0
+    out = []
+    for band in range((h + 7) // 8):
+        for x in range(w):
+            b = 0
+            for bit in range(8):
+                y = band * 8 + bit
+                if y < h and px[y][x]:
+                    b |= 1 << bit
+            out.append(b)
+    return out
+
+
+def atlas(name, height, spacing, glyphs):
+    codes = sorted(ord(c) for c in glyphs)
+    first, last = codes[0], codes[-1]
+    offsets, widths, data = [], [], []
+    for code in range(first, last + 1):
+        ch = chr(code)
+        if ch not in glyphs:
+            offsets.append(NO_GLYPH)
+            widths.append(0)
+            continue
+        px = glyphs[ch]
+        offsets.append(len(data))
+        widths.append(len(px[0]))
+        data.extend(pack(px, height))
+    return dict(name=name, first=first, height=height, spacing=spacing,
+                offsets=offsets, widths=widths, data=data)
+
+
+def c_list(items):
+    """Comma-separated initialiser lines, at most 80 columns."""
+    lines, line = [], "   "
+    for item in items:
+        if len(line) + len(item) + 2 > 80:
+            lines.append(line)
+            line = "   "
+        line += " " + item + ","
+    lines.append(line)
+    return "\n".join(lines)
+
+
+def emit(atlases):
+    out = [
+        "/**",
+        " * @file font_data.c",
+        " * @brief Packed font atlases",
+        " *",
+        " * Generated by master/tools/gen_fonts.py; do not edit.",
+        " */",
+        "",
+        '#include "font.h"',
+        "",
+    ]
+    for a in atlases:
+        n = a["name"]
+        out.append("// " + "=" * 60)
+        out.append("// " + n.upper().replace("_", " "))
+        out.append("// " + "=" * 60)
+        out.append(f"static const uint8_t {n}_bitmap[] = {{")
+        out.append(c_list("0x{:02X}".format(v) for v in a["data"]))
+        out.append("};")
+        out.append("")
+        out.append(f"static const uint16_t {n}_offset[] = {{")
+        offsets = ["FONT_NO_GLYPH" if v == NO_GLYPH else str(v)
+                   for v in a["offsets"]]
+        out.append(c_list(offsets))
+        out.append("};")
+        out.append("")
+        out.append(f"static const uint8_t {n}_width[] = {{")
+        out.append(c_list(str(v) for v in a["widths"]))
+        out.append("};")
+        out.append("")
+        out.append(f"const font_t {n} = {{")
+        out.append(f"    .first = {a['first']},")
+        out.append(f"    .count = {len(a['offsets'])},")
+        out.append(f"    .height = {a['height']},")
+        out.append(f"    .spacing = {a['spacing']},")
+        out.append(f"    .offset = {n}_offset,")
+        out.append(f"    .width = {n}_width,")
+        out.append(f"    .bitmap = {n}_bitmap,")
+        out.append("};")
+        out.append("")
+    return "\n".join(out)
+
+
+def main():
+    g57 = {chr(32 + i): columns_to_pixels(cols, 7)
+           for i, cols in enumerate(FONT_5X7)}
+    atlases = [
+        atlas("font_5x7", 7, 1, g57),
+        atlas("font_digits_8x16", 16, 2, segment_glyphs(8, 16, 2)),
+    ]
+    with open(OUT, "w") as f:
+        f.write(emit(atlases))
+
+
+if __name__ == "__main__":
+    main()
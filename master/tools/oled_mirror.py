@@ -0,0 +1,154 @@
+#!/usr/bin/env python3
+"""Show the OLED mirror streamed by the firmware (DISPLAY_MIRROR = 1).
+
+    python3 master/tools/oled_mirror.py /dev/ttyACM0 [--baud 115200]
+    python3 master/tools/oled_mirror.py capture.bin --pbm last.pbm
+
+Reads a serial port (needs pyserial) or a capture file ("-" = stdin),
+picks mirror frames out of the log stream, rebuilds the 128x64 image and
+draws it in the terminal. Log text is passed through to stderr. The frame
+format is described in master/main/drivers/display_mirror.h.
+"""
+
+import argparse
+import sys
+
+WIDTH, HEIGHT = 128, 64
+PAGES = HEIGHT // 8
+MAGIC = b"\xa5\x5a"
+FLAG_KEY = 0x01
+
+
+class Mirror:
+    def __init__(self):
+        self.fb = bytearray(WIDTH * PAGES)
+        self.synced = False  # Seen a keyframe
+        self.frames = 0
+        self.bad = 0
+
+    def apply(self, flags, mask, payload):
+        if flags & FLAG_KEY:
+            self.fb = bytearray(WIDTH * PAGES)
+            self.synced = True
+        pos = 0
+        for page in range(PAGES):
+            if not mask & (1 << page):
+                continue
+            x = 0
+            base = page * WIDTH
+            while x < WIDTH:
+                tok = payload[pos]
+                pos += 1
+                if tok < 0x80:
+                    x += tok + 1
+                else:
+                    n = tok - 0x7F
+                    for b in payload[pos:pos + n]:
+                        self.fb[base + x] ^= b
+                        x += 1
+                    pos += n
+        self.frames += 1
+
+    def pixel(self, x, y):
+        return (self.fb[(y // 8) * WIDTH + x] >> (y % 8)) & 1
+
+    def render(self):
+        rows = []
+        for y in range(0, HEIGHT, 2):
+            line = []
+            for x in range(WIDTH):
+                top, bot = self.pixel(x, y), self.pixel(x, y + 1)
+                line.append(" ▀▄█"[top | (bot << 1)])
+            rows.append("".join(line))
+        state = "" if self.synced else "  (waiting for keyframe)"
+        return "\x1b[H" + "\n".join(rows) + \
+            f"\nframes {self.frames}  bad {self.bad}{state}\x1b[K\n"
+
+    def pbm(self):
+        out = bytearray(f"P4\n{WIDTH} {HEIGHT}\n".encode())
+        for y in range(HEIGHT):
+            for xb in range(0, WIDTH, 8):
+                v = 0
+                for i in range(8):
+                    v |= self.pixel(xb + i, y) << (7 - i)
+                out.append(v)
+        return bytes(out)
+
+
+def parse(buf, mirror, text):
+    """Consume complete frames from buf; returns the unconsumed tail."""
+    while True:
+        i = buf.find(MAGIC)
+        if i < 0:
+            keep = 1 if buf.endswith(MAGIC[:1]) else 0
+            text(buf[:len(buf) - keep])
+            return buf[len(buf) - keep:]
+        text(buf[:i])
+        buf = buf[i:]
+        if len(buf) < 6:
+            return buf
+        flags, mask = buf[2], buf[3]
+        length = buf[4] | (buf[5] << 8)
+        if len(buf) < 6 + length + 1:
+            return buf
+        body = buf[2:6 + length]
+        if sum(body) & 0xFF != buf[6 + length]:
+            mirror.bad += 1
+            buf = buf[1:]  # False magic in log text
+            continue
+        mirror.apply(flags, mask, buf[6:6 + length])
+        buf = buf[6 + length + 1:]
+
+
+def open_source(args):
+    if args.source == "-":
+        return sys.stdin.buffer
+    try:
+        return open(args.source, "rb")
+    except OSError:
+        pass
+    import serial  # pyserial, only needed for live ports
+    return serial.Serial(args.source, args.baud, timeout=0.1)
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("source", help="serial port, capture file or -")
+    ap.add_argument("--baud", type=int, default=115200)
+    ap.add_argument("--pbm", help="write the last image to this PBM file")
+    ap.add_argument("--quiet", action="store_true",
+                    help="no terminal drawing")
+    args = ap.parse_args()
+
+    mirror = Mirror()
+    src = open_source(args)
+
+    def text(b):
+        if b:
+            sys.stderr.write(b.decode("utf-8", "replace"))
+
+    if not args.quiet:
+        sys.stdout.write("\x1b[2J")
+    buf = b""
+    try:
+        while True:
+            chunk = src.read(4096)
+            if not chunk:
+                if not hasattr(src, "in_waiting"):
+                    break  # End of file
+                continue
+            frames = mirror.frames
+            buf = parse(buf + chunk, mirror, text)
+            if not args.quiet and mirror.frames != frames:
+                sys.stdout.write(mirror.render())
+                sys.stdout.flush()
+    except KeyboardInterrupt:
+        pass
+
+    if args.pbm:
+        with open(args.pbm, "wb") as f:
+            f.write(mirror.pbm())
+
+
+if __name__ == "__main__":
+    main()
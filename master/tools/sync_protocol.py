@@ -0,0 +1,48 @@
+#!/usr/bin/env python3
+"""Copy the wire protocol header into the Arduino sketch folders.
+
+    python3 master/tools/sync_protocol.py          # update the copies
+    python3 master/tools/sync_protocol.py --check  # exit 1 if stale
+
+Arduino builds only see files next to the .ino, so each sketch carries a
+copy of master/main/comm/protocol.h. Edit the master copy, then run this.
+"""
+
+import os
+import sys
+
+ROOT = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "..")
+SOURCE = os.path.join(ROOT, "master", "main", "comm", "protocol.h")
+SKETCH_DIRS = ["remote_transmitter", "rc_mecanum", "."]  # "." = rc.ino
+
+BANNER = ("// Copy of master/main/comm/protocol.h, written by "
+          "master/tools/sync_protocol.py.\n// Do not edit here.\n")
+
+
+def main():
+    check = "--check" in sys.argv[1:]
+    with open(SOURCE) as f:
+        want = BANNER + f.read()
+
+    stale = []
+    for d in SKETCH_DIRS:
+        path = os.path.normpath(os.path.join(ROOT, d, "protocol.h"))
+        try:
+            with open(path) as f:
+                have = f.read()
+        except OSError:
+            have = None
+        if have == want:
+            continue
+        stale.append(path)
+        if not check:
+            with open(path, "w") as f:
+                f.write(want)
+
+    for path in stale:
+        print(("stale: " if check else "updated: ") + path)
+    return 1 if check and stale else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
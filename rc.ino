@@ -37,6 +37,8 @@
 #include <WiFi.h>
 #include <esp_now.h>
 
+#include "protocol.h"
+
 // ===== PILIH SERIAL PORT =====
 // Jika board punya USB-UART chip (CH340/CP2102), set ke true
 // Jika pakai native USB CDC, set ke false
@@ -79,7 +81,8 @@
 // ===== TIMEOUT =====
 #define CONNECTION_TIMEOUT 500 // ms tanpa data = stop motor
 
-// ===== STRUKTUR DATA YANG DITERIMA =====
+// ===== DATA JOYSTICK =====
+// Diterima sebagai proto_joystick_t (lihat protocol.h)
 typedef struct {
   int16_t throttle; // -255 to 255 (maju/mundur)
   int16_t steering; // -255 to 255 (kiri/kanan)
@@ -101,14 +104,37 @@ int rightSpeed = 0;
 // ===== CALLBACK SAAT DATA DITERIMA =====
 // Signature untuk ESP32 Arduino Core 2.0.x
 void OnDataRecv(const uint8_t *mac_addr, const uint8_t *data, int len) {
-  if (len == sizeof(RemoteData)) {
-    memcpy(&receivedData, data, sizeof(receivedData));
-    lastReceiveTime = millis();
-    dataReceived = true;
+  const proto_header_t *hdr;
+  if (proto_parse(data, len, &hdr) != PROTO_OK) {
+    return;
+  }
 
-    // LED berkedip saat menerima data
-    digitalWrite(LED_PIN, !digitalRead(LED_PIN));
+  // Format ringkas (remote 100Hz) atau format penuh
+  proto_joystick_t unpacked;
+  const proto_joystick_t *joy;
+  if (hdr->type == PROTO_MSG_JOYSTICK_COMPACT &&
+      hdr->length >= sizeof(proto_joystick_compact_t)) {
+    proto_joystick_unpack(
+        (const proto_joystick_compact_t *)proto_payload(hdr), &unpacked);
+    joy = &unpacked;
+  } else if (hdr->type == PROTO_MSG_JOYSTICK &&
+             hdr->length >= sizeof(proto_joystick_t)) {
+    joy = (const proto_joystick_t *)proto_payload(hdr);
+  } else {
+    return;
   }
+  receivedData.throttle = joy->throttle;
+  receivedData.steering = joy->steering;
+  receivedData.aux_x = joy->aux_x;
+  receivedData.aux_y = joy->aux_y;
+  receivedData.btn1 = joy->buttons & PROTO_BTN1;
+  receivedData.btn2 = joy->buttons & PROTO_BTN2;
+  receivedData.mode = joy->mode;
+  lastReceiveTime = millis();
+  dataReceived = true;
+
+  // LED berkedip saat menerima data
+  digitalWrite(LED_PIN, !digitalRead(LED_PIN));
 }
 
 // ===== SETUP =====
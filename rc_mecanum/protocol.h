@@ -0,0 +1,278 @@
+// Copy of master/main/comm/protocol.h, written by master/tools/sync_protocol.py.
+// Do not edit here.
+/**
+ * @file protocol.h
+ * @brief ESP-NOW wire protocol shared by the master and the sketches
+ *
+ * Every message is a packed little-endian header followed by a typed
+ * payload:
+ *
+ *   magic u16 | version u8 | type u8 | seq u16 | timestamp_ms u32 |
+ *   length u16 | crc u16 | payload[length]
+ *
+ * The CRC (CRC-16/CCITT-FALSE) covers the header up to the CRC field and
+ * the payload. Receivers validate a message where it lies and read the
+ * packed payload fields directly; nothing is copied first.
+ *
+ * Plain C, header-only, so the Arduino sketches can use it as is. The
+ * sketch folders hold copies kept in sync by master/tools/sync_protocol.py.
+ */
+
+#ifndef PROTOCOL_H
+#define PROTOCOL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define PROTO_MAGIC 0x4D52 // "RM" on the wire
+#define PROTO_VERSION 1
+
+#define PROTO_PACKED __attribute__((packed))
+
+#ifdef __cplusplus
+#define PROTO_STATIC_ASSERT(c, m) static_assert(c, m)
+#else
+#define PROTO_STATIC_ASSERT(c, m) _Static_assert(c, m)
+#endif
+
+typedef enum {
+  PROTO_MSG_JOYSTICK = 1,
+  PROTO_MSG_VOICE = 2,
+  PROTO_MSG_TELEMETRY = 3, // Master -> controller
+  PROTO_MSG_JOYSTICK_COMPACT = 4,
+  PROTO_MSG_COUNT,
+} proto_msg_type_t;
+
+typedef enum {
+  PROTO_OK,
+  PROTO_ERR_SHORT,   // Shorter than the header or its length field
+  PROTO_ERR_MAGIC,   // Not a protocol message
+  PROTO_ERR_VERSION, // Sender speaks another version
+  PROTO_ERR_CRC,     // Corrupted
+} proto_status_t;
+
+typedef struct PROTO_PACKED {
+  uint16_t magic;
+  uint8_t version;
+  uint8_t type;          // proto_msg_type_t
+  uint16_t seq;          // Per-sender counter, wraps
+  uint32_t timestamp_ms; // Sender clock (millis())
+  uint16_t length;       // Payload bytes
+  uint16_t crc;
+} proto_header_t;
+
+// ============================================================
+// PAYLOADS
+// ============================================================
+#define PROTO_BTN1 0x01 // Emergency stop
+#define PROTO_BTN2 0x02
+
+typedef struct PROTO_PACKED {
+  int16_t throttle; // -255 to 255
+  int16_t steering; // -255 to 255
+  int16_t aux_x;    // -255 to 255
+  int16_t aux_y;    // -255 to 255
+  uint8_t buttons;  // PROTO_BTN1 | PROTO_BTN2
+  uint8_t mode;
+} proto_joystick_t;
+
+// Bit-packed joystick, LSB first: throttle, steering, aux_x, aux_y as
+// 9-bit offset values (axis + PROTO_AXIS_BIAS), btn1, btn2, 2-bit mode.
+// Nine bits hold every axis value exactly; see proto_joystick_pack().
+#define PROTO_AXIS_BITS 9
+#define PROTO_AXIS_BIAS 255
+
+typedef struct PROTO_PACKED {
+  uint8_t bits[5];
+} proto_joystick_compact_t;
+
+typedef struct PROTO_PACKED {
+  uint8_t cmd; // VOICE_CMD_*
+  uint8_t speed;
+} proto_voice_t;
+
+#define PROTO_TLM_ESTOP 0x01 // Emergency stop latched (until re-centred)
+#define PROTO_TLM_JOY 0x02   // Master sees the joystick link
+#define PROTO_TLM_VOICE 0x04 // Master sees the voice module
+
+typedef struct PROTO_PACKED {
+  uint8_t state;       // Master FSM state
+  uint8_t movement;    // Movement class of the active mode
+  uint8_t flags;       // PROTO_TLM_*
+  int8_t rssi;         // This controller at the master, averaged (dBm)
+  int16_t duty[4];     // Wheel duties FL, FR, BL, BR, -255 to 255
+  uint16_t ack_seq;    // Newest sequence number received from it
+  uint16_t rx_packets; // Messages received from it (wraps)
+  uint16_t rx_lost;    // Messages lost from it (wraps)
+  uint16_t jitter_us;  // Its arrival jitter (saturates)
+} proto_telemetry_t;
+
+// Whole messages, for senders that build them in one struct
+typedef struct PROTO_PACKED {
+  proto_header_t hdr;
+  proto_joystick_t joy;
+} proto_joystick_msg_t;
+
+typedef struct PROTO_PACKED {
+  proto_header_t hdr;
+  proto_joystick_compact_t joy;
+} proto_joystick_compact_msg_t;
+
+typedef struct PROTO_PACKED {
+  proto_header_t hdr;
+  proto_voice_t voice;
+} proto_voice_msg_t;
+
+typedef struct PROTO_PACKED {
+  proto_header_t hdr;
+  proto_telemetry_t tlm;
+} proto_telemetry_msg_t;
+
+PROTO_STATIC_ASSERT(sizeof(proto_header_t) == 14, "header layout");
+PROTO_STATIC_ASSERT(sizeof(proto_joystick_t) == 10, "joystick layout");
+PROTO_STATIC_ASSERT(sizeof(proto_joystick_compact_t) == 5, "compact layout");
+PROTO_STATIC_ASSERT(2 * PROTO_AXIS_BIAS < (1 << PROTO_AXIS_BITS),
+                    "compact axes must be lossless");
+PROTO_STATIC_ASSERT(4 * PROTO_AXIS_BITS + 4 <=
+                        8 * sizeof(proto_joystick_compact_t),
+                    "compact fields must fit");
+PROTO_STATIC_ASSERT(sizeof(proto_voice_t) == 2, "voice layout");
+PROTO_STATIC_ASSERT(sizeof(proto_telemetry_t) == 20, "telemetry layout");
+
+// ============================================================
+// CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF), nibble table
+// ============================================================
+static inline uint16_t proto_crc16(uint16_t crc, const uint8_t *data,
+                                   size_t len) {
+  static const uint16_t table[16] = {
+      0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+      0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF,
+  };
+  for (size_t i = 0; i < len; i++) {
+    crc = (uint16_t)((crc << 4) ^ table[(crc >> 12) ^ (data[i] >> 4)]);
+    crc = (uint16_t)((crc << 4) ^ table[(crc >> 12) ^ (data[i] & 0x0F)]);
+  }
+  return crc;
+}
+
+static inline uint16_t proto_message_crc(const proto_header_t *hdr) {
+  const uint8_t *bytes = (const uint8_t *)hdr;
+  uint16_t crc = proto_crc16(0xFFFF, bytes, offsetof(proto_header_t, crc));
+  return proto_crc16(crc, bytes + sizeof(*hdr), hdr->length);
+}
+
+// ============================================================
+// COMPACT JOYSTICK
+// ============================================================
+static inline uint64_t proto_axis_field(int16_t v) {
+  if (v > PROTO_AXIS_BIAS)
+    v = PROTO_AXIS_BIAS;
+  if (v < -PROTO_AXIS_BIAS)
+    v = -PROTO_AXIS_BIAS;
+  return (uint64_t)(v + PROTO_AXIS_BIAS);
+}
+
+// Fields above 2 * PROTO_AXIS_BIAS are never sent; clamp them so a bad
+// sender cannot push an axis past +/-PROTO_AXIS_BIAS
+static inline int16_t proto_axis_value(uint64_t field) {
+  int v = (int)(field & ((1u << PROTO_AXIS_BITS) - 1)) - PROTO_AXIS_BIAS;
+  return (int16_t)(v > PROTO_AXIS_BIAS ? PROTO_AXIS_BIAS : v);
+}
+
+/**
+ * @brief Pack a joystick payload (axes clamped to +/-PROTO_AXIS_BIAS)
+ */
+static inline void proto_joystick_pack(const proto_joystick_t *in,
+                                       proto_joystick_compact_t *out) {
+  const int b = PROTO_AXIS_BITS;
+  uint64_t v = proto_axis_field(in->throttle) |
+               proto_axis_field(in->steering) << b |
+               proto_axis_field(in->aux_x) << (2 * b) |
+               proto_axis_field(in->aux_y) << (3 * b) |
+               (uint64_t)(in->buttons & 0x03) << (4 * b) |
+               (uint64_t)(in->mode & 0x03) << (4 * b + 2);
+
+  for (int i = 0; i < 5; i++)
+    out->bits[i] = (uint8_t)(v >> (8 * i));
+}
+
+/**
+ * @brief Unpack a compact joystick payload (axes within +/-PROTO_AXIS_BIAS)
+ */
+static inline void proto_joystick_unpack(const proto_joystick_compact_t *in,
+                                         proto_joystick_t *out) {
+  uint64_t v = 0;
+  for (int i = 0; i < 5; i++)
+    v |= (uint64_t)in->bits[i] << (8 * i);
+
+  const int b = PROTO_AXIS_BITS;
+  out->throttle = proto_axis_value(v);
+  out->steering = proto_axis_value(v >> b);
+  out->aux_x = proto_axis_value(v >> (2 * b));
+  out->aux_y = proto_axis_value(v >> (3 * b));
+  out->buttons = (uint8_t)((v >> (4 * b)) & 0x03);
+  out->mode = (uint8_t)((v >> (4 * b + 2)) & 0x03);
+}
+
+// ============================================================
+// SENDER
+// ============================================================
+/**
+ * @brief Fill in the header of a message whose payload follows it
+ * @param hdr Header, payload directly behind it
+ * @param type Message type
+ * @param seq Sequence number
+ * @param timestamp_ms Sender clock
+ * @param length Payload bytes
+ * @return Total message size to send
+ */
+static inline size_t proto_seal(proto_header_t *hdr, uint8_t type,
+                                uint16_t seq, uint32_t timestamp_ms,
+                                uint16_t length) {
+  hdr->magic = PROTO_MAGIC;
+  hdr->version = PROTO_VERSION;
+  hdr->type = type;
+  hdr->seq = seq;
+  hdr->timestamp_ms = timestamp_ms;
+  hdr->length = length;
+  hdr->crc = proto_message_crc(hdr);
+  return sizeof(*hdr) + length;
+}
+
+// ============================================================
+// RECEIVER
+// ============================================================
+/**
+ * @brief Validate a received message in place
+ * @param data Received bytes
+ * @param len Number of bytes
+ * @param out Header inside data (payload follows it), set on PROTO_OK
+ * @return PROTO_OK or the first check that failed
+ */
+static inline proto_status_t proto_parse(const uint8_t *data, size_t len,
+                                         const proto_header_t **out) {
+  const proto_header_t *hdr = (const proto_header_t *)data;
+
+  if (len < sizeof(*hdr))
+    return PROTO_ERR_SHORT;
+  if (hdr->magic != PROTO_MAGIC)
+    return PROTO_ERR_MAGIC;
+  if (hdr->version != PROTO_VERSION)
+    return PROTO_ERR_VERSION;
+  if (len < sizeof(*hdr) + hdr->length)
+    return PROTO_ERR_SHORT;
+  if (hdr->crc != proto_message_crc(hdr))
+    return PROTO_ERR_CRC;
+
+  *out = hdr;
+  return PROTO_OK;
+}
+
+/**
+ * @brief Payload of a validated message
+ */
+static inline const void *proto_payload(const proto_header_t *hdr) {
+  return (const uint8_t *)hdr + sizeof(*hdr);
+}
+
+#endif // PROTOCOL_H
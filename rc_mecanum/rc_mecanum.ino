@@ -54,6 +54,8 @@
 #include <WiFi.h>
 #include <esp_now.h>
 
+#include "protocol.h"
+
 // ===== PILIH SERIAL PORT =====
 #define USE_SERIAL0 true
 
@@ -104,7 +106,8 @@
 #define DIAGONAL_RATIO 0.6 // Rasio min untuk deteksi diagonal
 #define MAX_SPEED 200      // Kecepatan maksimum motor (0-255)
 
-// ===== STRUKTUR DATA YANG DITERIMA =====
+// ===== DATA JOYSTICK =====
+// Diterima sebagai proto_joystick_t (lihat protocol.h)
 // Hanya menggunakan 1 joystick (throttle = Y, steering = X)
 typedef struct {
   int16_t throttle; // -255 to 255 (Y axis)
@@ -128,14 +131,37 @@ int speedBR = 0; // Back Right
 
 // ===== CALLBACK SAAT DATA DITERIMA =====
 void OnDataRecv(const uint8_t *mac_addr, const uint8_t *data, int len) {
-  if (len == sizeof(RemoteData)) {
-    memcpy(&receivedData, data, sizeof(receivedData));
-    lastReceiveTime = millis();
-    dataReceived = true;
+  const proto_header_t *hdr;
+  if (proto_parse(data, len, &hdr) != PROTO_OK) {
+    return;
+  }
 
-    // LED berkedip saat menerima data
-    digitalWrite(LED_PIN, !digitalRead(LED_PIN));
+  // Format ringkas (remote 100Hz) atau format penuh
+  proto_joystick_t unpacked;
+  const proto_joystick_t *joy;
+  if (hdr->type == PROTO_MSG_JOYSTICK_COMPACT &&
+      hdr->length >= sizeof(proto_joystick_compact_t)) {
+    proto_joystick_unpack(
+        (const proto_joystick_compact_t *)proto_payload(hdr), &unpacked);
+    joy = &unpacked;
+  } else if (hdr->type == PROTO_MSG_JOYSTICK &&
+             hdr->length >= sizeof(proto_joystick_t)) {
+    joy = (const proto_joystick_t *)proto_payload(hdr);
+  } else {
+    return;
   }
+  receivedData.throttle = joy->throttle;
+  receivedData.steering = joy->steering;
+  receivedData.aux_x = joy->aux_x;
+  receivedData.aux_y = joy->aux_y;
+  receivedData.btn1 = joy->buttons & PROTO_BTN1;
+  receivedData.btn2 = joy->buttons & PROTO_BTN2;
+  receivedData.mode = joy->mode;
+  lastReceiveTime = millis();
+  dataReceived = true;
+
+  // LED berkedip saat menerima data
+  digitalWrite(LED_PIN, !digitalRead(LED_PIN));
 }
 
 // ===== APPLY DEADZONE =====
@@ -20,12 +20,18 @@
  *
  * LED Status:
  *   GPIO48 -> LED (Built-in pada beberapa ESP32-S3)
+ *   Nyala       : telemetri master diterima
+ *   Kedip cepat : emergency stop master masih terkunci
+ *   Tanpa telemetri: mengikuti ACK pengiriman (master lama)
  *
  * ===================================================
  */
 
 #include <WiFi.h>
 #include <esp_now.h>
+#include <stdarg.h>
+
+#include "protocol.h"
 
 // ===== PIN JOYSTICK 1 (KIRI) =====
 #define JOY1_X_PIN 1   // Steering (kiri-kanan)
@@ -47,9 +53,24 @@
 #define INVERT_JOY2_Y true  // Y: true
 
 // ===== KONFIGURASI =====
-#define SEND_INTERVAL 50 // Kirim data setiap 50ms (20Hz)
 #define DEADZONE 30 // Zona mati joystick (diperbesar untuk menghindari drift)
 #define DEBUG_SERIAL true // Debug via Serial
+#define LOOP_DELAY 1      // Jeda loop (ms); menentukan latensi deteksi
+
+// ===== JADWAL KIRIM ADAPTIF =====
+// Kirim segera saat input berubah, cepat saat bergerak, heartbeat saat diam.
+// Heartbeat harus jauh di bawah CONNECTION_TIMEOUT_MS master (500ms).
+#define SEND_MIN_GAP 5          // Jarak minimum antar paket (ms)
+#define SEND_ACTIVE_INTERVAL 10 // Saat bergerak (100Hz)
+#define SEND_IDLE_INTERVAL 100  // Heartbeat saat diam (10Hz)
+#define IDLE_LINGER 250         // Tetap cepat setelah berhenti (ulang STOP)
+#define CHANGE_THRESHOLD 8      // Perubahan sumbu yang langsung dikirim
+
+// ===== LOGGER =====
+#define LOG_BUF_SIZE 2048   // Ring buffer debug (byte)
+#define STATS_INTERVAL 1000 // Ringkasan pengiriman setiap 1 detik
+#define TLM_TIMEOUT 500   // Telemetri dianggap hilang setelah 500ms
+#define ESTOP_BLINK 100   // Periode kedip LED saat emergency stop (ms)
 
 // ===== MAC ADDRESS RECEIVER =====
 // GANTI DENGAN MAC ADDRESS ESP32-S3 RECEIVER ANDA!
@@ -57,7 +78,8 @@
 // FC:01:2C:D1:76:54
 uint8_t receiverMAC[] = {0xFC, 0x01, 0x2C, 0xD1, 0x76, 0x54};
 
-// ===== STRUKTUR DATA YANG DIKIRIM =====
+// ===== STATE JOYSTICK =====
+// Dikirim sebagai proto_joystick_compact_t (lihat protocol.h)
 typedef struct {
   int16_t throttle; // -255 to 255 (maju/mundur)
   int16_t steering; // -255 to 255 (kiri/kanan)
@@ -69,6 +91,19 @@ typedef struct {
 } RemoteData;
 
 RemoteData dataToSend;
+RemoteData lastSent; // Isi paket terakhir yang dikirim
+
+// ===== PAKET PROTOKOL =====
+// Format ringkas: 19 byte per paket (format penuh 24 byte)
+proto_joystick_compact_msg_t txMsg;
+uint16_t txSeq = 0;
+
+// ===== TELEMETRI DARI MASTER =====
+// Diisi oleh OnDataRecv (task WiFi), dibaca di loop()
+proto_telemetry_t rxTlm;
+volatile bool tlmNew = false;
+volatile unsigned long lastTlmTime = 0;
+portMUX_TYPE tlmMux = portMUX_INITIALIZER_UNLOCKED;
 
 // ===== KALIBRASI (akan diisi saat startup) =====
 int joy1_x_center = 2048;
@@ -80,20 +115,98 @@ int joy2_y_center = 2048;
 esp_now_peer_info_t peerInfo;
 bool peerConnected = false;
 unsigned long lastSendTime = 0;
-int sendFailCount = 0;
+unsigned long lastMotionTime = 0;
+volatile int sendFailCount = 0;
+
+// Statistik per STATS_INTERVAL: paket per alasan kirim
+uint32_t sendChange = 0, sendActive = 0, sendHeartbeat = 0;
+
+// ===== LOGGER NON-BLOCKING =====
+// Hanya dipanggil dari loop(). Baris yang tidak muat di ring dibuang dan
+// dihitung; logFlush() hanya menulis sebanyak ruang kosong TX Serial,
+// jadi loop tidak pernah menunggu UART.
+char logBuf[LOG_BUF_SIZE];
+size_t logHead = 0, logTail = 0; // Posisi tulis / baca (terus naik)
+uint32_t logDropped = 0;
+
+void logPrintf(const char *fmt, ...) {
+  if (!DEBUG_SERIAL) {
+    return;
+  }
+
+  char line[128];
+  va_list args;
+  va_start(args, fmt);
+  int n = vsnprintf(line, sizeof(line), fmt, args);
+  va_end(args);
+  if (n < 0) {
+    return;
+  }
+  if (n >= (int)sizeof(line)) {
+    n = sizeof(line) - 1;
+  }
+
+  if (LOG_BUF_SIZE - (logHead - logTail) < (size_t)n) {
+    logDropped++;
+    return;
+  }
+  for (int i = 0; i < n; i++) {
+    logBuf[(logHead + i) % LOG_BUF_SIZE] = line[i];
+  }
+  logHead += n;
+}
+
+void logFlush() {
+  while (logHead != logTail) {
+    size_t room = Serial.availableForWrite();
+    if (room == 0) {
+      return;
+    }
+
+    // Bagian bersambung sampai ujung buffer
+    size_t start = logTail % LOG_BUF_SIZE;
+    size_t len = logHead - logTail;
+    if (len > LOG_BUF_SIZE - start) {
+      len = LOG_BUF_SIZE - start;
+    }
+    if (len > room) {
+      len = room;
+    }
+    Serial.write((const uint8_t *)&logBuf[start], len);
+    logTail += len;
+  }
+}
 
 // ===== CALLBACK SAAT DATA TERKIRIM =====
 void OnDataSent(const uint8_t *mac_addr, esp_now_send_status_t status) {
+  // LED mengikuti ACK hanya jika master tidak mengirim telemetri
+  bool ackLed = millis() - lastTlmTime > TLM_TIMEOUT;
   if (status == ESP_NOW_SEND_SUCCESS) {
-    digitalWrite(LED_PIN, HIGH);
+    if (ackLed)
+      digitalWrite(LED_PIN, HIGH);
     sendFailCount = 0;
   } else {
-    digitalWrite(LED_PIN, LOW);
-    sendFailCount++;
-    if (DEBUG_SERIAL && sendFailCount > 10) {
-      Serial.println("!!! Koneksi ke receiver terputus !!!");
-    }
+    if (ackLed)
+      digitalWrite(LED_PIN, LOW);
+    sendFailCount++; // Dilaporkan dari loop()
+  }
+}
+
+// ===== CALLBACK SAAT DATA DITERIMA (TELEMETRI) =====
+void OnDataRecv(const uint8_t *mac_addr, const uint8_t *data, int len) {
+  const proto_header_t *hdr;
+  if (memcmp(mac_addr, receiverMAC, 6) != 0 ||
+      proto_parse(data, len, &hdr) != PROTO_OK ||
+      hdr->type != PROTO_MSG_TELEMETRY ||
+      hdr->length < sizeof(proto_telemetry_t)) {
+    return;
   }
+
+  portENTER_CRITICAL(&tlmMux);
+  memcpy(&rxTlm, proto_payload(hdr), sizeof(rxTlm));
+  tlmNew = true;
+  portEXIT_CRITICAL(&tlmMux);
+  lastTlmTime = millis();
 }
 
 // ===== SETUP =====
@@ -168,6 +281,7 @@ void setup() {
 
   // Daftarkan callback
   esp_now_register_send_cb(OnDataSent);
+  esp_now_register_recv_cb(OnDataRecv);
 
   // Tambahkan peer (receiver)
   memcpy(peerInfo.peer_addr, receiverMAC, 6);
@@ -257,34 +371,121 @@ void readInputs() {
   static bool lastBtn2 = false;
   if (dataToSend.btn2 && !lastBtn2) {
     dataToSend.mode = (dataToSend.mode + 1) % 3;
-    Serial.print("Mode changed to: ");
-    Serial.println(dataToSend.mode);
+    logPrintf("Mode changed to: %u\n", dataToSend.mode);
   }
   lastBtn2 = dataToSend.btn2;
 }
 
 // ===== KIRIM DATA =====
-void sendData() {
-  esp_err_t result =
-      esp_now_send(receiverMAC, (uint8_t *)&dataToSend, sizeof(dataToSend));
-
-  if (DEBUG_SERIAL) {
-    Serial.print("T:");
-    Serial.print(dataToSend.throttle);
-    Serial.print(" S:");
-    Serial.print(dataToSend.steering);
-    Serial.print(" AX:");
-    Serial.print(dataToSend.aux_x);
-    Serial.print(" AY:");
-    Serial.print(dataToSend.aux_y);
-    Serial.print(" B1:");
-    Serial.print(dataToSend.btn1);
-    Serial.print(" B2:");
-    Serial.print(dataToSend.btn2);
-    Serial.print(" M:");
-    Serial.print(dataToSend.mode);
-    Serial.print(" -> ");
-    Serial.println(result == ESP_OK ? "OK" : "FAIL");
+void sendData(char reason) {
+  proto_joystick_t joy;
+  joy.throttle = dataToSend.throttle;
+  joy.steering = dataToSend.steering;
+  joy.aux_x = dataToSend.aux_x;
+  joy.aux_y = dataToSend.aux_y;
+  joy.buttons = (dataToSend.btn1 ? PROTO_BTN1 : 0) |
+                (dataToSend.btn2 ? PROTO_BTN2 : 0);
+  joy.mode = dataToSend.mode;
+  proto_joystick_pack(&joy, &txMsg.joy);
+
+  size_t len = proto_seal(&txMsg.hdr, PROTO_MSG_JOYSTICK_COMPACT, txSeq++,
+                          millis(), sizeof(txMsg.joy));
+  esp_err_t result = esp_now_send(receiverMAC, (uint8_t *)&txMsg, len);
+  lastSent = dataToSend;
+
+  logPrintf("%c T:%d S:%d AX:%d AY:%d B1:%d B2:%d M:%u -> %s\n", reason,
+            dataToSend.throttle, dataToSend.steering, dataToSend.aux_x,
+            dataToSend.aux_y, dataToSend.btn1, dataToSend.btn2,
+            dataToSend.mode, result == ESP_OK ? "OK" : "FAIL");
+}
+
+// ===== JADWAL KIRIM ADAPTIF =====
+bool inputChanged() {
+  return abs(dataToSend.throttle - lastSent.throttle) > CHANGE_THRESHOLD ||
+         abs(dataToSend.steering - lastSent.steering) > CHANGE_THRESHOLD ||
+         abs(dataToSend.aux_x - lastSent.aux_x) > CHANGE_THRESHOLD ||
+         abs(dataToSend.aux_y - lastSent.aux_y) > CHANGE_THRESHOLD ||
+         dataToSend.btn1 != lastSent.btn1 ||
+         dataToSend.btn2 != lastSent.btn2 || dataToSend.mode != lastSent.mode;
+}
+
+bool inMotion() {
+  return dataToSend.throttle || dataToSend.steering || dataToSend.aux_x ||
+         dataToSend.aux_y || dataToSend.btn1 || dataToSend.btn2;
+}
+
+// Alasan kirim sekarang: 'C' berubah, 'A' bergerak, 'H' heartbeat, 0 tidak
+char sendReason(unsigned long now) {
+  unsigned long since = now - lastSendTime;
+
+  if (inMotion()) {
+    lastMotionTime = now;
+  }
+  if (since < SEND_MIN_GAP) {
+    return 0;
+  }
+  if (inputChanged()) {
+    return 'C';
+  }
+  if (now - lastMotionTime < IDLE_LINGER && since >= SEND_ACTIVE_INTERVAL) {
+    return 'A';
+  }
+  if (since >= SEND_IDLE_INTERVAL) {
+    return 'H';
+  }
+  return 0;
+}
+
+void logStats(unsigned long now) {
+  static unsigned long lastStats = 0;
+  static bool linkLost = false;
+
+  if (sendFailCount > 10 && !linkLost) {
+    logPrintf("!!! Koneksi ke receiver terputus !!!\n");
+  }
+  linkLost = sendFailCount > 10;
+
+  if (now - lastStats < STATS_INTERVAL) {
+    return;
+  }
+  lastStats = now;
+  logPrintf("TX/s: %lu (ubah:%lu gerak:%lu heartbeat:%lu) log hilang:%lu\n",
+            (unsigned long)(sendChange + sendActive + sendHeartbeat),
+            (unsigned long)sendChange, (unsigned long)sendActive,
+            (unsigned long)sendHeartbeat, (unsigned long)logDropped);
+  sendChange = sendActive = sendHeartbeat = 0;
+}
+
+// ===== TAMPILKAN TELEMETRI =====
+void handleTelemetry() {
+  static bool estop = false;
+  bool fresh = millis() - lastTlmTime <= TLM_TIMEOUT;
+
+  if (tlmNew) {
+    proto_telemetry_t tlm;
+    portENTER_CRITICAL(&tlmMux);
+    tlm = rxTlm;
+    tlmNew = false;
+    portEXIT_CRITICAL(&tlmMux);
+
+    estop = tlm.flags & PROTO_TLM_ESTOP;
+    int16_t duty[4];
+    memcpy(duty, tlm.duty, sizeof(duty));
+    logPrintf("TLM st:%u mv:%u%s FL:%d FR:%d BL:%d BR:%d "
+              "rssi:%d ack:%u rx:%u lost:%u jit:%uus\n",
+              tlm.state, tlm.movement, estop ? " ESTOP" : "", duty[0],
+              duty[1], duty[2], duty[3], tlm.rssi, tlm.ack_seq,
+              tlm.rx_packets, tlm.rx_lost, tlm.jitter_us);
+  }
+
+  // Tanpa telemetri, LED diatur oleh OnDataSent
+  if (!fresh) {
+    return;
+  }
+  if (estop) {
+    digitalWrite(LED_PIN, (millis() / ESTOP_BLINK) & 1);
+  } else {
+    digitalWrite(LED_PIN, HIGH);
   }
 }
 
@@ -293,12 +494,27 @@ void loop() {
   // Baca semua input
   readInputs();
 
-  // Kirim data dengan interval
-  if (millis() - lastSendTime >= SEND_INTERVAL) {
-    sendData();
-    lastSendTime = millis();
+  // Umpan balik dari master
+  handleTelemetry();
+
+  // Kirim saat perlu (lihat sendReason)
+  unsigned long now = millis();
+  char reason = sendReason(now);
+  if (reason) {
+    sendData(reason);
+    lastSendTime = now;
+    if (reason == 'C')
+      sendChange++;
+    else if (reason == 'A')
+      sendActive++;
+    else
+      sendHeartbeat++;
   }
 
+  // Debug Serial tanpa menunggu UART
+  logStats(now);
+  logFlush();
+
   // Small delay untuk stabilitas ADC
-  delay(5);
+  delay(LOOP_DELAY);
 }